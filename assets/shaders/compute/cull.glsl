@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+// License
+////////////////////////////////////////////////////////////////////////////////
+
+// Copyright (c) 2023 Klayton Kowalski
+// 
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+#version 460 core
+
+////////////////////////////////////////////////////////////////////////////////
+// Macros
+////////////////////////////////////////////////////////////////////////////////
+
+#define MY_BINDING_CAMERA 0
+#define MY_BINDING_INSTANCE 1
+#define MY_BINDING_INDIRECT 2
+
+#define MY_UNIFORM_CULL_OFFSET 0
+#define MY_UNIFORM_CULL_COUNT 1
+#define MY_UNIFORM_CULL_STRIDE 2
+#define MY_UNIFORM_CULL_BOUNDS 3
+#define MY_UNIFORM_CULL_INSTANCE 4
+
+////////////////////////////////////////////////////////////////////////////////
+// Inputs
+////////////////////////////////////////////////////////////////////////////////
+
+layout (local_size_x = 64) in;
+
+////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////
+
+struct MyIndirect
+{
+    uint indexCount;
+    uint instanceCount;
+    uint indexOffset;
+    uint vertexOffset;
+    uint instanceOffset;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Uniforms
+////////////////////////////////////////////////////////////////////////////////
+
+layout (std140, binding = MY_BINDING_CAMERA) uniform MyCamera
+{
+    mat4 view;
+    mat4 projection;
+}
+myUniformCamera;
+
+layout (std430, binding = MY_BINDING_INSTANCE) readonly buffer MyInstances
+{
+    float values[];
+}
+myBufferInstances;
+
+layout (std430, binding = MY_BINDING_INDIRECT) buffer MyIndirects
+{
+    MyIndirect commands[];
+}
+myBufferIndirects;
+
+layout (location = MY_UNIFORM_CULL_OFFSET) uniform uint myUniformCullOffset;
+layout (location = MY_UNIFORM_CULL_COUNT) uniform uint myUniformCullCount;
+layout (location = MY_UNIFORM_CULL_STRIDE) uniform uint myUniformCullStride;
+layout (location = MY_UNIFORM_CULL_BOUNDS) uniform uint myUniformCullBounds;
+layout (location = MY_UNIFORM_CULL_INSTANCE) uniform uint myUniformCullInstance;
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+void main()
+{
+    const uint commandIndex = gl_GlobalInvocationID.x;
+    if (commandIndex >= myUniformCullCount)
+    {
+        return;
+    }
+    const uint commandOffset = myUniformCullOffset + commandIndex;
+    const uint boundsOffset = (myUniformCullInstance + myBufferIndirects.commands[commandOffset].instanceOffset) * myUniformCullStride + myUniformCullBounds;
+    const vec4 center = vec4(myBufferInstances.values[boundsOffset], myBufferInstances.values[boundsOffset + 1], myBufferInstances.values[boundsOffset + 2], 1.0f);
+    const float radius = myBufferInstances.values[boundsOffset + 3];
+    const mat4 clip = transpose(myUniformCamera.projection * myUniformCamera.view);
+    uint instanceCount = 1;
+    for (int i = 0; i < 3; i++)
+    {
+        const vec4 lower = clip[3] + clip[i];
+        const vec4 upper = clip[3] - clip[i];
+        if (dot(lower, center) < -radius * length(lower.xyz) || dot(upper, center) < -radius * length(upper.xyz))
+        {
+            instanceCount = 0;
+        }
+    }
+    myBufferIndirects.commands[commandOffset].instanceCount = instanceCount;
+}
\ No newline at end of file
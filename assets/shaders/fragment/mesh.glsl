@@ -1,14 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+// License
+////////////////////////////////////////////////////////////////////////////////
+
+// Copyright (c) 2023 Klayton Kowalski
+// 
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+
+////////////////////////////////////////////////////////////////////////////////
+
+
 #version 460 core
 
+////////////////////////////////////////////////////////////////////////////////
+// Macros
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef MY_BINDLESS
+#extension GL_ARB_bindless_texture : require
+#endif
+
+#define MY_BINDING_TEXTURE 0
+
 #define MY_UNIFORM_MESH_TEXTURE 0
 
-out vec4 outMeshColor;
+////////////////////////////////////////////////////////////////////////////////
+// Outputs
+////////////////////////////////////////////////////////////////////////////////
+
+out vec4 myOutMeshColor;
+
+////////////////////////////////////////////////////////////////////////////////
+// Forwards
+////////////////////////////////////////////////////////////////////////////////
 
-in vec2 forwardMeshTexture;
+in vec2 myForwardMeshTexture;
+flat in uint myForwardMeshLayer;
+
+////////////////////////////////////////////////////////////////////////////////
+// Uniforms
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef MY_BINDLESS
+layout (std430, binding = MY_BINDING_TEXTURE) readonly buffer MyTextures
+{
+    uvec2 handles[];
+}
+myBufferTextures;
+#else
+layout (location = MY_UNIFORM_MESH_TEXTURE) uniform sampler2DArray myUniformMeshTexture;
+#endif
 
-layout (location = MY_UNIFORM_MESH_TEXTURE) uniform sampler2D uniformTexture;
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
 
 void main()
 {
-    outMeshColor = texture(uniformTexture, forwardMeshTexture);
+#ifdef MY_BINDLESS
+    myOutMeshColor = texture(sampler2D(myBufferTextures.handles[myForwardMeshLayer]), myForwardMeshTexture);
+#else
+    myOutMeshColor = texture(myUniformMeshTexture, vec3(myForwardMeshTexture, myForwardMeshLayer));
+#endif
 }
\ No newline at end of file
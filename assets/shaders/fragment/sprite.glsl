@@ -26,6 +26,12 @@
 // Macros
 ////////////////////////////////////////////////////////////////////////////////
 
+#ifdef MY_BINDLESS
+#extension GL_ARB_bindless_texture : require
+#endif
+
+#define MY_BINDING_TEXTURE 0
+
 #define MY_UNIFORM_SPRITE_TEXTURE 0
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -39,12 +45,21 @@ out vec4 myOutSpriteColor;
 ////////////////////////////////////////////////////////////////////////////////
 
 in vec2 myForwardSpriteTexture;
+flat in uint myForwardSpriteLayer;
 
 ////////////////////////////////////////////////////////////////////////////////
 // Uniforms
 ////////////////////////////////////////////////////////////////////////////////
 
-layout (location = MY_UNIFORM_SPRITE_TEXTURE) uniform sampler2D myUniformSpriteTexture;
+#ifdef MY_BINDLESS
+layout (std430, binding = MY_BINDING_TEXTURE) readonly buffer MyTextures
+{
+    uvec2 handles[];
+}
+myBufferTextures;
+#else
+layout (location = MY_UNIFORM_SPRITE_TEXTURE) uniform sampler2DArray myUniformSpriteTexture;
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 // Functions
@@ -52,5 +67,9 @@ layout (location = MY_UNIFORM_SPRITE_TEXTURE) uniform sampler2D myUniformSpriteT
 
 void main()
 {
-    myOutSpriteColor = texture(myUniformSpriteTexture, myForwardSpriteTexture);
+#ifdef MY_BINDLESS
+    myOutSpriteColor = texture(sampler2D(myBufferTextures.handles[myForwardSpriteLayer]), myForwardSpriteTexture);
+#else
+    myOutSpriteColor = texture(myUniformSpriteTexture, vec3(myForwardSpriteTexture, myForwardSpriteLayer));
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+// License
+////////////////////////////////////////////////////////////////////////////////
+
+// Copyright (c) 2023 Klayton Kowalski
+// 
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+#version 460 core
+
+////////////////////////////////////////////////////////////////////////////////
+// Macros
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef MY_BINDLESS
+#extension GL_ARB_bindless_texture : require
+#endif
+
+#define MY_BINDING_TEXTURE 0
+
+#define MY_UNIFORM_VOXEL_TEXTURE 0
+
+////////////////////////////////////////////////////////////////////////////////
+// Outputs
+////////////////////////////////////////////////////////////////////////////////
+
+out vec4 myOutVoxelColor;
+
+////////////////////////////////////////////////////////////////////////////////
+// Forwards
+////////////////////////////////////////////////////////////////////////////////
+
+in vec2 myForwardVoxelTexture;
+flat in vec4 myForwardVoxelFrame;
+flat in uint myForwardVoxelLayer;
+flat in float myForwardVoxelShade;
+
+////////////////////////////////////////////////////////////////////////////////
+// Uniforms
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef MY_BINDLESS
+layout (std430, binding = MY_BINDING_TEXTURE) readonly buffer MyTextures
+{
+    uvec2 handles[];
+}
+myBufferTextures;
+#else
+layout (location = MY_UNIFORM_VOXEL_TEXTURE) uniform sampler2DArray myUniformVoxelTexture;
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+void main()
+{
+    const vec2 coordinate = myForwardVoxelFrame.xy + fract(myForwardVoxelTexture) * myForwardVoxelFrame.zw;
+#ifdef MY_BINDLESS
+    const vec4 color = texture(sampler2D(myBufferTextures.handles[myForwardVoxelLayer]), coordinate);
+#else
+    const vec4 color = texture(myUniformVoxelTexture, vec3(coordinate, myForwardVoxelLayer));
+#endif
+    myOutVoxelColor = vec4(color.rgb * myForwardVoxelShade, color.a);
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+////////////////////////////////////////////////////////////////////////////////
+// License
+////////////////////////////////////////////////////////////////////////////////
+
+// Copyright (c) 2023 Klayton Kowalski
+// 
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+
+////////////////////////////////////////////////////////////////////////////////
+
+#version 460 core
+
+////////////////////////////////////////////////////////////////////////////////
+// Forwards
+////////////////////////////////////////////////////////////////////////////////
+
+out vec2 myForwardLayerTexture;
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+void main()
+{
+    const vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(corner * 2.0f - 1.0f, -1.0f, 1.0f);
+    myForwardLayerTexture = corner;
+}
\ No newline at end of file
@@ -1,18 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+// License
+////////////////////////////////////////////////////////////////////////////////
+
+// Copyright (c) 2023 Klayton Kowalski
+// 
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+
+////////////////////////////////////////////////////////////////////////////////
+
+
 #version 460 core
 
+////////////////////////////////////////////////////////////////////////////////
+// Macros
+////////////////////////////////////////////////////////////////////////////////
+
 #define MY_BINDING_CAMERA 0
 
 #define MY_ATTRIBUTE_MESH_POSITION 0
 #define MY_ATTRIBUTE_MESH_TEXTURE 1
 #define MY_ATTRIBUTE_MESH_NORMAL 2
 #define MY_ATTRIBUTE_MESH_TRANSFORM 3
+#define MY_ATTRIBUTE_MESH_LAYER 7
+
+////////////////////////////////////////////////////////////////////////////////
+// Inputs
+////////////////////////////////////////////////////////////////////////////////
 
 layout (location = MY_ATTRIBUTE_MESH_POSITION) in vec3 myAttributeMeshPosition;
 layout (location = MY_ATTRIBUTE_MESH_TEXTURE) in vec2 myAttributeMeshTexture;
-layout (location = MY_ATTRIBUTE_MESH_NORMAL) in vec2 myAttributeMeshNormal;
+layout (location = MY_ATTRIBUTE_MESH_NORMAL) in vec3 myAttributeMeshNormal;
 layout (location = MY_ATTRIBUTE_MESH_TRANSFORM) in mat4 myAttributeMeshTransform;
+layout (location = MY_ATTRIBUTE_MESH_LAYER) in uint myAttributeMeshLayer;
+
+////////////////////////////////////////////////////////////////////////////////
+// Forwards
+////////////////////////////////////////////////////////////////////////////////
 
 out vec2 myForwardMeshTexture;
+flat out uint myForwardMeshLayer;
+
+////////////////////////////////////////////////////////////////////////////////
+// Uniforms
+////////////////////////////////////////////////////////////////////////////////
 
 layout (std140, binding = MY_BINDING_CAMERA) uniform MyCamera
 {
@@ -21,8 +63,13 @@ layout (std140, binding = MY_BINDING_CAMERA) uniform MyCamera
 }
 myUniformCamera;
 
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
 void main()
 {
     gl_Position = myUniformCamera.projection * myUniformCamera.view * myAttributeMeshTransform * vec4(myAttributeMeshPosition, 1.0f);
     myForwardMeshTexture = myAttributeMeshTexture;
+    myForwardMeshLayer = myAttributeMeshLayer;
 }
\ No newline at end of file
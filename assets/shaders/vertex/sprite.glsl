@@ -27,10 +27,13 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #define MY_BINDING_CAMERA 0
+#define MY_BINDING_FRAME 3
 
 #define MY_ATTRIBUTE_SPRITE_POSITION 0
 #define MY_ATTRIBUTE_SPRITE_TEXTURE 1
-#define MY_ATTRIBUTE_SPRITE_TRANSFORM 2
+#define MY_ATTRIBUTE_SPRITE_ORIGIN 2
+#define MY_ATTRIBUTE_SPRITE_SIZE 3
+#define MY_ATTRIBUTE_SPRITE_FRAME 4
 
 ////////////////////////////////////////////////////////////////////////////////
 // Inputs
@@ -38,13 +41,16 @@
 
 layout (location = MY_ATTRIBUTE_SPRITE_POSITION) in vec3 myAttributeSpritePosition;
 layout (location = MY_ATTRIBUTE_SPRITE_TEXTURE) in vec2 myAttributeSpriteTexture;
-layout (location = MY_ATTRIBUTE_SPRITE_TRANSFORM) in mat4 myAttributeSpriteTransform;
+layout (location = MY_ATTRIBUTE_SPRITE_ORIGIN) in vec4 myAttributeSpriteOrigin;
+layout (location = MY_ATTRIBUTE_SPRITE_SIZE) in vec2 myAttributeSpriteSize;
+layout (location = MY_ATTRIBUTE_SPRITE_FRAME) in uint myAttributeSpriteFrame;
 
 ////////////////////////////////////////////////////////////////////////////////
 // Forwards
 ////////////////////////////////////////////////////////////////////////////////
 
 out vec2 myForwardSpriteTexture;
+flat out uint myForwardSpriteLayer;
 
 ////////////////////////////////////////////////////////////////////////////////
 // Uniforms
@@ -57,12 +63,29 @@ layout (std140, binding = MY_BINDING_CAMERA) uniform MyCamera
 }
 myUniformCamera;
 
+layout (std430, binding = MY_BINDING_FRAME) readonly buffer MyFrames
+{
+    uvec4 frames[];
+}
+myBufferFrames;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Functions
 ////////////////////////////////////////////////////////////////////////////////
 
 void main()
 {
-    gl_Position = myUniformCamera.projection * myUniformCamera.view * myAttributeSpriteTransform * vec4(myAttributeSpritePosition, 1.0f);
-    myForwardSpriteTexture = myAttributeSpriteTexture;
+    const float cosRotation = cos(myAttributeSpriteOrigin.w);
+    const float sinRotation = sin(myAttributeSpriteOrigin.w);
+    const mat4 transform = mat4
+    (
+        cosRotation * myAttributeSpriteSize.x, -sinRotation * myAttributeSpriteSize.x, 0.0f, 0.0f,
+        sinRotation * myAttributeSpriteSize.y, cosRotation * myAttributeSpriteSize.y, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        myAttributeSpriteOrigin.xyz, 1.0f
+    );
+    gl_Position = myUniformCamera.projection * myUniformCamera.view * transform * vec4(myAttributeSpritePosition, 1.0f);
+    const uvec4 frame = myBufferFrames.frames[myAttributeSpriteFrame];
+    myForwardSpriteTexture = unpackUnorm2x16(frame.x) + myAttributeSpriteTexture * unpackUnorm2x16(frame.y);
+    myForwardSpriteLayer = frame.z;
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+// License
+////////////////////////////////////////////////////////////////////////////////
+
+// Copyright (c) 2023 Klayton Kowalski
+// 
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+#version 460 core
+
+////////////////////////////////////////////////////////////////////////////////
+// Macros
+////////////////////////////////////////////////////////////////////////////////
+
+#define MY_BINDING_CAMERA 0
+#define MY_BINDING_FRAME 3
+
+#define MY_ATTRIBUTE_VOXEL_VERTEX 0
+
+#define MY_UNIFORM_VOXEL_ORIGIN 1
+#define MY_UNIFORM_VOXEL_FRAME 2
+#define MY_UNIFORM_VOXEL_COUNT 3
+
+////////////////////////////////////////////////////////////////////////////////
+// Inputs
+////////////////////////////////////////////////////////////////////////////////
+
+layout (location = MY_ATTRIBUTE_VOXEL_VERTEX) in uint myAttributeVoxelVertex;
+
+////////////////////////////////////////////////////////////////////////////////
+// Forwards
+////////////////////////////////////////////////////////////////////////////////
+
+out vec2 myForwardVoxelTexture;
+flat out vec4 myForwardVoxelFrame;
+flat out uint myForwardVoxelLayer;
+flat out float myForwardVoxelShade;
+
+////////////////////////////////////////////////////////////////////////////////
+// Uniforms
+////////////////////////////////////////////////////////////////////////////////
+
+layout (std140, binding = MY_BINDING_CAMERA) uniform MyCamera
+{
+    mat4 view;
+    mat4 projection;
+}
+myUniformCamera;
+
+layout (std430, binding = MY_BINDING_FRAME) readonly buffer MyFrames
+{
+    uvec4 frames[];
+}
+myBufferFrames;
+
+layout (location = MY_UNIFORM_VOXEL_ORIGIN) uniform vec3 myUniformVoxelOrigin;
+layout (location = MY_UNIFORM_VOXEL_FRAME) uniform uint myUniformVoxelFrame;
+layout (location = MY_UNIFORM_VOXEL_COUNT) uniform uint myUniformVoxelCount;
+
+////////////////////////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////////////////////////
+
+const float myVoxelShades[6] = float[6](0.8f, 0.8f, 0.5f, 1.0f, 0.65f, 0.65f);
+
+////////////////////////////////////////////////////////////////////////////////
+// Functions
+////////////////////////////////////////////////////////////////////////////////
+
+void main()
+{
+    const vec3 position = vec3(myAttributeVoxelVertex & 31u, (myAttributeVoxelVertex >> 5u) & 511u, (myAttributeVoxelVertex >> 14u) & 31u);
+    const uint face = (myAttributeVoxelVertex >> 19u) & 7u;
+    const uint block = myAttributeVoxelVertex >> 22u;
+    gl_Position = myUniformCamera.projection * myUniformCamera.view * vec4(myUniformVoxelOrigin + position, 1.0f);
+    const uint axis = face >> 1u;
+    myForwardVoxelTexture = axis == 0u ? position.zy : axis == 1u ? position.xz : position.xy;
+    const uint slot = block - 1u < myUniformVoxelCount ? myUniformVoxelFrame + block - 1u : myUniformVoxelFrame;
+    const uvec4 frame = myBufferFrames.frames[slot];
+    myForwardVoxelFrame = vec4(unpackUnorm2x16(frame.x), unpackUnorm2x16(frame.y));
+    myForwardVoxelLayer = frame.z;
+    myForwardVoxelShade = myVoxelShades[face];
+}
\ No newline at end of file
@@ -20,4 +20,5 @@
 
 ################################################################################
 
-set(MY_OPTION_EXAMPLES ON CACHE BOOL "Build example projects.")
\ No newline at end of file
+set(MY_OPTION_EXAMPLES ON CACHE BOOL "Build example projects.")
+set(MY_OPTION_BINDLESS OFF CACHE BOOL "Use bindless textures when the driver supports them.")
\ No newline at end of file
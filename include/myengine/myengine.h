@@ -40,6 +40,13 @@
 #define MY_DEFAULT_SHADER_MESH 2
 #define MY_DEFAULT_CAMERA_ORTHOGRAPHIC 1
 #define MY_DEFAULT_CAMERA_PERSPECTIVE 2
+#define MY_DEFAULT_GEOMETRY_QUAD 1
+#define MY_DEFAULT_GEOMETRY_CUBE 2
+#define MY_DEFAULT_GEOMETRY_SPHERE 3
+#define MY_DEFAULT_GEOMETRY_CYLINDER 4
+
+#define MY_TILE_EMPTY -1
+#define MY_VOXEL_EMPTY -1
 
 #define MY_COLOR_WHITE (MyColor) { 1.0f, 1.0f, 1.0f, 1.0f }
 #define MY_COLOR_BLACK (MyColor) { 0.0f, 0.0f, 0.0f, 1.0f }
@@ -189,6 +196,23 @@ typedef enum MyKeyState
 }
 MyKeyState;
 
+typedef enum MyAnimationMode
+{
+    MY_ANIMATION_MODE_ONCE,
+    MY_ANIMATION_MODE_LOOP,
+    MY_ANIMATION_MODE_PING_PONG
+}
+MyAnimationMode;
+
+typedef enum MySortMode
+{
+    MY_SORT_MODE_NONE,
+    MY_SORT_MODE_Y,
+    MY_SORT_MODE_LAYER_Y,
+    MY_SORT_MODE_KEY
+}
+MySortMode;
+
 typedef struct MyColor
 {
     float red;
@@ -229,8 +253,10 @@ MY_API void my_window_set_size(int width, int height);
 MY_API void my_window_set_title(const char* title);
 MY_API void my_window_set_color(MyColor color);
 MY_API void my_window_set_viewport(float x, float y, float width, float height);
+MY_API bool my_window_set_resolution(int width, int height);
 MY_API void my_window_set_vsync(bool vsync);
 MY_API void my_window_set_depth(bool depth);
+MY_API void my_window_set_culling(bool culling);
 MY_API void my_window_set_cursor(bool cursor);
 
 MY_API float my_window_get_cursor(float* x, float* y);
@@ -238,19 +264,29 @@ MY_API float my_window_get_cursor_delta(float* x, float* y);
 MY_API MyKeyState my_window_get_key_state(MyKey key);
 MY_API float my_window_get_time(void);
 MY_API int my_window_get_frame_rate(void);
+MY_API void my_window_get_state_calls(int* issued, int* avoided);
 
 ////////////////////////////////////////////////////////////////////////////////
 // Entity Functions
 ////////////////////////////////////////////////////////////////////////////////
 
 MY_API MyHandle my_entity_create_sprite(float width, float height);
-MY_API MyHandle my_entity_create_mesh(void);
+MY_API MyHandle my_entity_create_mesh(MyHandle geometryHandle);
+MY_API MyHandle my_entity_bake(const MyHandle* entityHandles, int entityCount);
+MY_API bool my_entity_reserve(MyHandle entityHandle, int entityCount);
 MY_API void my_entity_destroy(MyHandle entityHandle);
 MY_API void my_entity_move(MyHandle entityHandle, MyVector distance);
 MY_API void my_entity_scale(MyHandle entityHandle, MyVector scale);
 MY_API void my_entity_rotate(MyHandle entityHandle, MyVector rotation);
 
+MY_API void my_entity_set_texture(MyHandle entityHandle, MyHandle textureHandle);
+MY_API void my_entity_set_frame(MyHandle entityHandle, int frameIndex);
 MY_API void my_entity_set_visible(MyHandle entityHandle, bool visible);
+MY_API void my_entity_set_static(MyHandle entityHandle, bool stationary);
+MY_API void my_entity_set_layer(MyHandle entityHandle, MyHandle layerHandle);
+MY_API void my_entity_set_sort_mode(MyHandle entityHandle, MySortMode sortMode);
+MY_API void my_entity_set_sort_layer(MyHandle entityHandle, int sortLayer);
+MY_API void my_entity_set_sort_key(MyHandle entityHandle, float sortKey);
 MY_API void my_entity_set_position(MyHandle entityHandle, MyVector position);
 MY_API void my_entity_set_scale(MyHandle entityHandle, MyVector scale);
 MY_API void my_entity_set_rotation(MyHandle entityHandle, MyVector rotation);
@@ -259,6 +295,14 @@ MY_API MyVector my_entity_get_position(MyHandle entityHandle);
 MY_API MyVector my_entity_get_scale(MyHandle entityHandle);
 MY_API MyVector my_entity_get_rotation(MyHandle entityHandle);
 
+////////////////////////////////////////////////////////////////////////////////
+// Geometry Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MY_API MyHandle my_geometry_create(const float* vertices, int vertexCount, const void* indices, int indexCount, int indexSize);
+MY_API MyHandle my_geometry_load(const char* meshPath);
+MY_API void my_geometry_destroy(MyHandle geometryHandle);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Texture Functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -308,6 +352,61 @@ MY_API void my_clock_set_callback(MyHandle clockHandle, MyClockCallback callback
 MY_API float my_clock_get_time(MyHandle clockHandle);
 MY_API float my_clock_get_progress(MyHandle clockHandle);
 
+////////////////////////////////////////////////////////////////////////////////
+// Animation Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MY_API MyHandle my_animation_create(MyHandle entityHandle, const int* frameIndices, int frameCount, float frameDuration, MyAnimationMode mode);
+MY_API void my_animation_destroy(MyHandle animationHandle);
+MY_API bool my_animation_start(MyHandle animationHandle);
+MY_API void my_animation_stop(MyHandle animationHandle);
+MY_API void my_animation_reset(MyHandle animationHandle);
+
+MY_API void my_animation_set_clock(MyHandle animationHandle, MyHandle clockHandle);
+MY_API void my_animation_set_duration(MyHandle animationHandle, float frameDuration);
+
+MY_API bool my_animation_get_playing(MyHandle animationHandle);
+
+////////////////////////////////////////////////////////////////////////////////
+// Tilemap Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MY_API MyHandle my_tilemap_create(MyHandle textureHandle, int columnCount, int rowCount, float tileWidth, float tileHeight);
+MY_API void my_tilemap_destroy(MyHandle tilemapHandle);
+
+MY_API void my_tilemap_set_tile(MyHandle tilemapHandle, int column, int row, int frameIndex);
+MY_API void my_tilemap_set_texture(MyHandle tilemapHandle, MyHandle textureHandle);
+MY_API void my_tilemap_set_position(MyHandle tilemapHandle, MyVector position);
+MY_API void my_tilemap_set_visible(MyHandle tilemapHandle, bool visible);
+
+MY_API int my_tilemap_get_tile(MyHandle tilemapHandle, int column, int row);
+
+////////////////////////////////////////////////////////////////////////////////
+// Voxel Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MY_API MyHandle my_voxel_create(MyHandle textureHandle, int chunkColumnCount, int chunkRowCount);
+MY_API void my_voxel_destroy(MyHandle voxelHandle);
+
+MY_API void my_voxel_set_block(MyHandle voxelHandle, int x, int y, int z, int frameIndex);
+MY_API void my_voxel_set_texture(MyHandle voxelHandle, MyHandle textureHandle);
+MY_API void my_voxel_set_position(MyHandle voxelHandle, MyVector position);
+MY_API void my_voxel_set_visible(MyHandle voxelHandle, bool visible);
+
+MY_API int my_voxel_get_block(MyHandle voxelHandle, int x, int y, int z);
+
+////////////////////////////////////////////////////////////////////////////////
+// Layer Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MY_API MyHandle my_layer_create(MyHandle cameraHandle, int width, int height);
+MY_API void my_layer_destroy(MyHandle layerHandle);
+
+MY_API void my_layer_redraw(MyHandle layerHandle);
+MY_API void my_layer_set_camera(MyHandle layerHandle, MyHandle cameraHandle);
+MY_API void my_layer_set_visible(MyHandle layerHandle, bool visible);
+MY_API void my_layer_set_front(MyHandle layerHandle, bool front);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Float Functions
 ////////////////////////////////////////////////////////////////////////////////
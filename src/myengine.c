@@ -32,10 +32,29 @@
 #include <stb_image/stb_image.h>
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+#include <float.h>
 #include <math.h>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MY_SIMD_SSE
+#include <xmmintrin.h>
+#endif
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 // Macros
 ////////////////////////////////////////////////////////////////////////////////
@@ -49,27 +68,70 @@
 #define MY_ALLOCATOR_SHADER 10
 #define MY_ALLOCATOR_CAMERA 10
 #define MY_ALLOCATOR_CLOCK 10
+#define MY_ALLOCATOR_ANIMATION 1000
+#define MY_ALLOCATOR_GEOMETRY 10
+#define MY_ALLOCATOR_TILEMAP 10
+#define MY_ALLOCATOR_VOXEL 10
+#define MY_ALLOCATOR_VOXEL_VERTEX 4096
+#define MY_ALLOCATOR_VOXEL_QUAD 4096
+#define MY_ALLOCATOR_LAYER 10
 #define MY_ALLOCATOR_BATCH 100
 #define MY_ALLOCATOR_BATCH_ENTITY 100
-#define MY_ALLOCATOR_BATCH_VERTEX 10000
-#define MY_ALLOCATOR_BATCH_INDEX 10000
+#define MY_ALLOCATOR_BATCH_TABLE 64
+#define MY_ALLOCATOR_SORT 256
+#define MY_ALLOCATOR_BUCKET 10
+#define MY_ALLOCATOR_BUCKET_LAYER 16
+#define MY_ALLOCATOR_POOL_ENTITY 1000
+#define MY_ALLOCATOR_POOL_VERTEX 100000
+#define MY_ALLOCATOR_POOL_INDEX 200000
+#define MY_ALLOCATOR_FRAME 1024
 
 #define MY_CAPACITY_CAMERA sizeof(MyTransform) * 2
+#define MY_CAPACITY_RING 3
+
+#define MY_FLAGS_RING (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT)
 
 #define MY_BUFFER_ENTITY_VERTEX 0
-#define MY_BUFFER_ENTITY_TRANSFORM 1
+#define MY_BUFFER_ENTITY_INSTANCE 1
 #define MY_BUFFER_CAMERA 0
+#define MY_BUFFER_TEXTURE 0
+#define MY_BUFFER_CULL_INSTANCE 1
+#define MY_BUFFER_CULL_INDIRECT 2
+#define MY_BUFFER_FRAME 3
 
 #define MY_UNIFORM_ENTITY_TEXTURE 0
+#define MY_UNIFORM_CULL_OFFSET 0
+#define MY_UNIFORM_CULL_COUNT 1
+#define MY_UNIFORM_CULL_STRIDE 2
+#define MY_UNIFORM_CULL_BOUNDS 3
+#define MY_UNIFORM_CULL_INSTANCE 4
+#define MY_UNIFORM_VOXEL_ORIGIN 1
+#define MY_UNIFORM_VOXEL_FRAME 2
+#define MY_UNIFORM_VOXEL_COUNT 3
+
+#define MY_WORKGROUP_CULL 64
+
+#define MY_CAPACITY_PLANE 6
+#define MY_CAPACITY_SEGMENT 32
+#define MY_CAPACITY_STACK 16
+#define MY_CAPACITY_CHUNK 32
+#define MY_CAPACITY_VOXEL_X 16
+#define MY_CAPACITY_VOXEL_Y 256
+#define MY_CAPACITY_VOXEL_Z 16
+#define MY_CAPACITY_VOXEL_FRAME 1023
+#define MY_CAPACITY_WORKER 4
 
 #define MY_SAMPLER_ENTITY 0
 
+#define MY_CAPACITY_SAMPLER 1
+#define MY_CAPACITY_STORAGE 4
+#define MY_CAPACITY_BINDING 2
+
 #define MY_ATTRIBUTE_SPRITE_POSITION 0
 #define MY_ATTRIBUTE_SPRITE_TEXTURE 1
-#define MY_ATTRIBUTE_SPRITE_TRANSFORM_X 2
-#define MY_ATTRIBUTE_SPRITE_TRANSFORM_Y 3
-#define MY_ATTRIBUTE_SPRITE_TRANSFORM_Z 4
-#define MY_ATTRIBUTE_SPRITE_TRANSFORM_W 5
+#define MY_ATTRIBUTE_SPRITE_ORIGIN 2
+#define MY_ATTRIBUTE_SPRITE_SIZE 3
+#define MY_ATTRIBUTE_SPRITE_FRAME 4
 
 #define MY_ATTRIBUTE_MESH_POSITION 0
 #define MY_ATTRIBUTE_MESH_TEXTURE 1
@@ -78,11 +140,91 @@
 #define MY_ATTRIBUTE_MESH_TRANSFORM_Y 4
 #define MY_ATTRIBUTE_MESH_TRANSFORM_Z 5
 #define MY_ATTRIBUTE_MESH_TRANSFORM_W 6
+#define MY_ATTRIBUTE_MESH_LAYER 7
+
+#define MY_ATTRIBUTE_VOXEL_VERTEX 0
+
+#define MY_MESH_MAGIC 0x534D594Du
+#define MY_MESH_VERSION 1
+
+#define MY_GEOMETRY_SEED 14695981039346656037ull
+#define MY_GEOMETRY_PRIME 1099511628211ull
 
 ////////////////////////////////////////////////////////////////////////////////
 // Types
 ////////////////////////////////////////////////////////////////////////////////
 
+typedef GLuint64 (GLAD_API_PTR *MyGetTextureHandle)(GLuint texture);
+typedef void (GLAD_API_PTR *MyMakeTextureHandleResident)(GLuint64 handle);
+typedef void (GLAD_API_PTR *MyMakeTextureHandleNonResident)(GLuint64 handle);
+
+#ifdef _WIN32
+typedef HANDLE MyThread;
+typedef CRITICAL_SECTION MyMutex;
+typedef CONDITION_VARIABLE MyCondition;
+typedef DWORD MyThreadResult;
+#define MY_THREAD_CALL WINAPI
+#else
+typedef pthread_t MyThread;
+typedef pthread_mutex_t MyMutex;
+typedef pthread_cond_t MyCondition;
+typedef void* MyThreadResult;
+#define MY_THREAD_CALL
+#endif
+
+typedef MyThreadResult (MY_THREAD_CALL *MyThreadFunction)(void* argument);
+
+typedef struct MySortItem
+{
+    GLuint64 key;
+    int value;
+}
+MySortItem;
+
+typedef struct MyPlane
+{
+    MyVector normal;
+    float distance;
+}
+MyPlane;
+
+typedef struct MyMapping
+{
+    void* data;
+    size_t size;
+}
+MyMapping;
+
+typedef struct MyMeshHeader
+{
+    GLuint magic;
+    GLuint version;
+    GLuint vertexCount;
+    GLuint indexCount;
+    GLuint indexSize;
+    GLuint vertexOffset;
+    GLuint indexOffset;
+    GLuint padding;
+}
+MyMeshHeader;
+
+typedef struct MyGeometry
+{
+    MyHandle geometryHandle;
+    GLuint64 hash;
+    MyVector boundsCenter;
+    float boundsRadius;
+    int vertexCount;
+    int indexCount;
+    int indexSize;
+    int vertexBase;
+    int indexBase;
+    int referenceCount;
+    int baseCount;
+    unsigned char* data;
+}
+MyGeometry;
+
 typedef struct MyIndirect
 {
     unsigned int indexCount;
@@ -93,10 +235,46 @@ typedef struct MyIndirect
 }
 MyIndirect;
 
+typedef struct MySpriteInstance
+{
+    float x;
+    float y;
+    float z;
+    float rotation;
+    float width;
+    float height;
+    GLuint frame;
+}
+MySpriteInstance;
+
+typedef struct MyFrame
+{
+    GLushort x;
+    GLushort y;
+    GLushort width;
+    GLushort height;
+    GLuint layer;
+    GLuint padding;
+}
+MyFrame;
+
+typedef struct MyMeshInstance
+{
+    MyTransform transform;
+    GLuint layer;
+    float boundsX;
+    float boundsY;
+    float boundsZ;
+    float boundsRadius;
+}
+MyMeshInstance;
+
 typedef enum MyEntityType
 {
     MY_ENTITY_TYPE_SPRITE,
-    MY_ENTITY_TYPE_MESH
+    MY_ENTITY_TYPE_MESH,
+    MY_ENTITY_TYPE_VOXEL,
+    MY_ENTITY_TYPE_COUNT
 }
 MyEntityType;
 
@@ -106,20 +284,30 @@ typedef struct MyEntity
     MyHandle textureHandle;
     MyHandle shaderHandle;
     MyHandle batchHandle;
-    GLfloat* vertices;
-    GLushort* indices;
+    MyHandle geometryHandle;
+    MyHandle layerHandle;
     MyEntityType type;
     MyVector position;
     MyVector scale;
     MyVector rotation;
     MyTransform transform;
+    float width;
+    float height;
+    MyVector boundsCenter;
+    float boundsRadius;
     int entityIndex;
-    int vertexCount;
-    int vertexSize;
-    int vertexOffset;
-    int indexCount;
-    int indexIndex;
+    int indexSize;
     int frameIndex;
+    MySortMode sortMode;
+    int sortLayer;
+    float sortKey;
+    MyHandle animationHandle;
+    MyHandle textureNext;
+    MyHandle texturePrevious;
+    MyHandle shaderNext;
+    MyHandle shaderPrevious;
+    bool dirty;
+    bool stationary;
 }
 MyEntity;
 
@@ -137,7 +325,12 @@ typedef struct MyTexture
     MyHandle textureHandle;
     stbi_uc* pixels;
     MyTextureFrame* frames;
+    MyHandle bucketHandle;
+    int layerIndex;
+    int frameBase;
     GLuint texture;
+    GLuint64 residentHandle;
+    MyHandle entityFirst;
     int width;
     int height;
     int channelCount;
@@ -146,6 +339,18 @@ typedef struct MyTexture
 }
 MyTexture;
 
+typedef struct MyBucket
+{
+    MyHandle bucketHandle;
+    MyHandle* layerTextures;
+    GLuint texture;
+    int width;
+    int height;
+    int layerCapacity;
+    int layerCount;
+}
+MyBucket;
+
 typedef struct MyShader
 {
     MyHandle shaderHandle;
@@ -154,6 +359,7 @@ typedef struct MyShader
     GLuint program;
     char* vertexText;
     char* fragmentText;
+    MyHandle entityFirst;
 }
 MyShader;
 
@@ -183,6 +389,8 @@ typedef struct MyCamera
     MyVector basisZ;
     MyTransform viewTransform;
     MyTransform projectionTransform;
+    MyPlane planes[MY_CAPACITY_PLANE];
+    int planeCount;
     bool dirty;
 }
 MyCamera;
@@ -195,28 +403,184 @@ typedef struct MyClock
     float totalTime;
     float interval;
     float intervalTime;
+    float frameTime;
     bool active;
 }
 MyClock;
 
-typedef struct MyBatch
+typedef struct MyAnimation
 {
-    MyHandle batchHandle;
+    MyHandle animationHandle;
+    MyHandle entityHandle;
+    MyHandle clockHandle;
+    int* frameIndices;
+    int frameCount;
+    int frameCursor;
+    int frameDirection;
+    float frameDuration;
+    float frameTime;
+    MyAnimationMode mode;
+    int playingIndex;
+    bool playing;
+}
+MyAnimation;
+
+typedef struct MyChunk
+{
+    GLushort tiles[MY_CAPACITY_CHUNK * MY_CAPACITY_CHUNK];
+    GLuint instanceBuffer;
+    int instanceCount;
+    bool dirty;
+}
+MyChunk;
+
+typedef struct MyTilemap
+{
+    MyHandle tilemapHandle;
     MyHandle textureHandle;
-    MyHandle shaderHandle;
+    MyChunk* chunks;
+    MyVector position;
+    float tileWidth;
+    float tileHeight;
+    int columnCount;
+    int rowCount;
+    int chunkColumnCount;
+    int chunkRowCount;
+    bool visible;
+}
+MyTilemap;
+
+typedef struct MyVoxelChunk
+{
+    GLushort blocks[MY_CAPACITY_VOXEL_X * MY_CAPACITY_VOXEL_Y * MY_CAPACITY_VOXEL_Z];
+    GLuint vertexBuffer;
+    int vertexCapacity;
+    int vertexCount;
+    bool dirty;
+    bool meshing;
+}
+MyVoxelChunk;
+
+typedef struct MyVoxel
+{
+    MyHandle voxelHandle;
+    MyHandle textureHandle;
+    MyVoxelChunk* chunks;
+    MyVector position;
+    int chunkColumnCount;
+    int chunkRowCount;
+    int serial;
+    bool visible;
+}
+MyVoxel;
+
+typedef struct MyVoxelJob
+{
+    struct MyVoxelJob* next;
+    MyHandle voxelHandle;
+    int chunkIndex;
+    int serial;
+    GLushort* blocks;
+    GLuint* vertices;
+    int vertexCount;
+    int vertexCapacity;
+    bool failed;
+}
+MyVoxelJob;
+
+typedef struct MyLayer
+{
+    MyHandle layerHandle;
+    MyHandle cameraHandle;
+    GLuint framebuffer;
+    GLuint colorTexture;
+    GLuint depthBuffer;
+    int width;
+    int height;
+    bool dirty;
+    bool visible;
+    bool front;
+}
+MyLayer;
+
+typedef struct MyPool
+{
     GLuint vertexFormat;
     GLuint vertexBuffer;
     GLuint indexBuffer;
-    GLuint transformBuffer;
+    GLuint instanceBuffer;
     GLuint indirectBuffer;
-    MyEntityType entityType;
-    int entityCapacity;
-    int entityCount;
+    unsigned char* instanceRing;
+    MyIndirect* indirectRing;
+    int instanceSize;
+    int instanceCapacity;
+    int instanceCount;
+    int vertexSize;
     int vertexCapacity;
-    int vertexCount;
     int vertexOffset;
     int indexCapacity;
-    int indexCount;
+    int indexOffset;
+    int drawCount;
+    GLuint bindingBuffers[MY_CAPACITY_BINDING];
+    GLintptr bindingOffsets[MY_CAPACITY_BINDING];
+    GLuint elementBuffer;
+}
+MyPool;
+
+typedef struct MyState
+{
+    GLuint program;
+    GLuint vertexFormat;
+    GLuint indirectBuffer;
+    GLuint textures[MY_CAPACITY_SAMPLER];
+    GLuint storageBuffers[MY_CAPACITY_STORAGE];
+    MyColor color;
+    bool depthTest;
+    bool blend;
+    bool depthMask;
+    GLenum blendSource;
+    GLenum blendDestination;
+    GLenum blendSourceAlpha;
+    GLenum blendDestinationAlpha;
+    int issuedCount;
+    int avoidedCount;
+    int frameIssuedCount;
+    int frameAvoidedCount;
+}
+MyState;
+
+typedef struct MyBatch
+{
+    MyHandle batchHandle;
+    MyHandle bucketHandle;
+    MyHandle shaderHandle;
+    MyHandle layerHandle;
+    GLuint instanceBuffer;
+    unsigned char* instances;
+    MyHandle* entityHandles;
+    int* entityOrder;
+    GLuint64* entityKeys;
+    float* boundsX;
+    float* boundsY;
+    float* boundsZ;
+    float* boundsRadius;
+    bool* entityVisible;
+    int ringFirst[MY_CAPACITY_RING];
+    int ringLast[MY_CAPACITY_RING];
+    MyEntityType entityType;
+    MySortMode sortMode;
+    int instanceSize;
+    int entityCapacity;
+    int entityCount;
+    int indexSize;
+    int instanceBase;
+    int drawFirst;
+    int drawCount;
+    float depth;
+    bool transparent;
+    bool stationary;
+    bool baked;
+    bool sorted;
 }
 MyBatch;
 
@@ -228,7 +592,19 @@ typedef struct MyEngine
     MyShader* shaders;
     MyCamera* cameras;
     MyClock* clocks;
+    MyAnimation* animations;
+    MyTilemap* tilemaps;
+    MyVoxel* voxels;
+    MyGeometry* geometries;
+    MyLayer* layers;
     MyBatch* batches;
+    MyHandle* batchTable;
+    MyBucket* buckets;
+    MyPool pools[MY_ENTITY_TYPE_COUNT];
+    MyState state;
+    MyHandle* dirtyEntities;
+    MySortItem* sortItems;
+    MySortItem* sortScratch;
     int windowX;
     int windowY;
     int windowWidth;
@@ -237,6 +613,11 @@ typedef struct MyEngine
     float viewportY;
     float viewportWidth;
     float viewportHeight;
+    GLuint sceneFramebuffer;
+    GLuint sceneColor;
+    GLuint sceneDepth;
+    int sceneWidth;
+    int sceneHeight;
     double cursorX;
     double cursorY;
     double cursorDeltaX;
@@ -250,9 +631,53 @@ typedef struct MyEngine
     int shaderCapacity;
     int cameraCapacity;
     int clockCapacity;
+    int animationCapacity;
+    int tilemapCapacity;
+    int geometryCapacity;
+    int voxelCapacity;
+    int voxelSerial;
+    MyHandle voxelShader;
+    MyThread voxelThreads[MY_CAPACITY_WORKER];
+    int voxelThreadCount;
+    MyMutex voxelMutex;
+    MyCondition voxelCondition;
+    MyVoxelJob* voxelQueueFirst;
+    MyVoxelJob* voxelQueueLast;
+    MyVoxelJob* voxelResults;
+    bool voxelQuit;
+    bool voxelRunning;
+    int layerCapacity;
+    MyHandle layerShader;
+    GLuint layerFormat;
+    MyHandle* playingHandles;
+    MyHandle* playingClocks;
+    float* playingTimes;
+    float* playingDurations;
+    int playingCapacity;
+    int playingCount;
     int batchCapacity;
+    int batchTableCapacity;
+    int batchCount;
+    int bucketCapacity;
+    int layerLimit;
+    int dirtyCapacity;
+    int dirtyCount;
+    int sortCapacity;
     GLuint cameraBuffer;
+    GLuint cullProgram;
+    GLuint residentBuffer;
+    int residentCapacity;
+    GLuint frameBuffer;
+    int frameCapacity;
+    int frameOffset;
+    MyGetTextureHandle getTextureHandle;
+    MyMakeTextureHandleResident makeTextureHandleResident;
+    MyMakeTextureHandleNonResident makeTextureHandleNonResident;
+    bool bindless;
+    bool culling;
     MyHandle cameraHandle;
+    GLsync ringFences[MY_CAPACITY_RING];
+    int ringIndex;
 }
 MyEngine;
 
@@ -262,23 +687,156 @@ MyEngine;
 
 static void my_window_position_callback(GLFWwindow* window, int x, int y);
 static void my_window_size_callback(GLFWwindow* window, int width, int height);
+static void my_window_present(void);
+
+static void my_entity_mark(MyHandle entityHandle);
+static void my_entity_update(MyHandle entityHandle);
+static MyHandle my_entity_allocate(void);
+
+static bool my_geometry_reserve(int vertexCapacity, int indexCapacity);
+static void my_geometry_release(MyHandle geometryHandle);
+static void my_geometry_bound(MyHandle geometryHandle, const float* vertices);
+static bool my_geometry_equal(MyHandle geometryHandle, const float* vertices, const void* indices);
+static GLuint64 my_geometry_hash(GLuint64 hash, const void* data, size_t size);
+static void my_geometry_vertex(float* vertices, int vertexIndex, MyVector position, MyVector normal, float u, float v);
+static MyHandle my_geometry_quad(void);
+static MyHandle my_geometry_cube(void);
+static MyHandle my_geometry_sphere(void);
+static MyHandle my_geometry_cylinder(void);
+
+static bool my_texture_reside(MyHandle textureHandle);
+static bool my_texture_allocate(MyHandle textureHandle);
+static void my_texture_release(MyHandle textureHandle);
+static void my_texture_upload(MyHandle textureHandle);
+static MyFrame my_texture_frame(MyHandle textureHandle, int frameIndex);
+static GLuint my_texture_slot(MyHandle textureHandle, int frameIndex);
+static void my_texture_link(MyHandle entityHandle);
+static void my_texture_unlink(MyHandle entityHandle);
+
+static bool my_shader_compile(GLuint stage, const char* text);
+static GLuint my_shader_compute(const char* computePath);
+static void my_shader_link(MyHandle entityHandle);
+static void my_shader_unlink(MyHandle entityHandle);
 
 static void my_camera_update(MyHandle cameraHandle);
+static bool my_camera_contains(MyVector minimum, MyVector maximum);
 
 static void my_clock_frame_callback(MyHandle clockHandle);
 
+static bool my_animation_insert(MyHandle animationHandle);
+static void my_animation_erase(MyHandle animationHandle);
+static void my_animation_advance(MyHandle animationHandle);
+
+static void my_tilemap_mark(MyHandle tilemapHandle);
+static void my_tilemap_refresh(MyHandle textureHandle);
+static void my_tilemap_unlink(MyHandle textureHandle);
+static bool my_tilemap_build(MyHandle tilemapHandle, int chunkIndex);
+static bool my_tilemap_clip(MyHandle tilemapHandle, int chunkIndex);
+static void my_tilemap_draw(MyHandle tilemapHandle);
+
+static bool my_voxel_start(void);
+static void my_voxel_stop(void);
+static GLushort my_voxel_block(MyHandle voxelHandle, int x, int y, int z);
+static void my_voxel_mark(MyHandle voxelHandle, int x, int z);
+static void my_voxel_snapshot(MyHandle voxelHandle, int chunkIndex, GLushort* blocks);
+static void my_voxel_dispatch(MyHandle voxelHandle);
+static void my_voxel_collect(void);
+static bool my_voxel_upload(MyHandle voxelHandle, int chunkIndex, const GLuint* vertices, int vertexCount);
+static bool my_voxel_reserve(int quadCount);
+static MyThreadResult MY_THREAD_CALL my_voxel_work(void* argument);
+static bool my_voxel_mesh(MyVoxelJob* job);
+static bool my_voxel_emit(MyVoxelJob* job, const int* corner, int face, GLushort block);
+static void my_voxel_draw(MyHandle voxelHandle);
+static void my_voxel_unlink(MyHandle textureHandle);
+
+static void my_layer_render(MyHandle layerHandle, int batchCount);
+static void my_layer_composite(bool front);
+
+static bool my_thread_create(MyThread* thread, MyThreadFunction function, void* argument);
+static void my_thread_join(MyThread thread);
+static bool my_mutex_create(MyMutex* mutex);
+static void my_mutex_destroy(MyMutex* mutex);
+static void my_mutex_lock(MyMutex* mutex);
+static void my_mutex_unlock(MyMutex* mutex);
+static bool my_condition_create(MyCondition* condition);
+static void my_condition_destroy(MyCondition* condition);
+static void my_condition_wait(MyCondition* condition, MyMutex* mutex);
+static void my_condition_broadcast(MyCondition* condition);
+
+static bool my_file_map(const char* path, MyMapping* mapping);
+static void my_file_unmap(MyMapping* mapping);
+
 static MyHandle my_batch_create(MyHandle entityHandle);
 static void my_batch_destroy(MyHandle batchHandle);
+static bool my_batch_allocate(MyHandle batchHandle, int entityCapacity);
+static void my_batch_store(MyHandle entityHandle);
+static void my_batch_touch(MyHandle batchHandle, int firstIndex, int lastIndex);
+static bool my_batch_reserve(MyHandle batchHandle, int entityCount);
+static GLuint my_batch_resize(GLuint buffer, int size, int capacity);
+static unsigned int my_batch_hash(MyHandle shaderHandle, MyHandle bucketHandle, MyEntityType entityType, int indexSize, bool transparent, bool stationary, MySortMode sortMode, MyHandle layerHandle);
+static bool my_batch_insert(MyHandle batchHandle);
+static void my_batch_erase(MyHandle batchHandle);
 static MyHandle my_batch_match(MyHandle entityHandle);
 static bool my_batch_add(MyHandle entityHandle);
+static float my_batch_depth(MyHandle batchHandle, int entityIndex);
+static GLuint64 my_batch_key(MyHandle batchHandle);
+static GLuint my_batch_bits(float value);
+static bool my_batch_order(MyHandle batchHandle);
+static bool my_batch_scratch(int count);
+static void my_batch_sort(MySortItem* items, int count);
+static void my_batch_clip(MyHandle batchHandle);
+static void my_batch_upload(MyHandle batchHandle);
+static bool my_batch_bake(MyHandle batchHandle);
+static bool my_batch_compatible(MyHandle batchHandle, MyHandle otherHandle);
+static void my_batch_draw(int batchCount, MyHandle layerHandle);
 static void my_batch_remove(MyHandle entityHandle);
 
+static bool my_pool_create(MyEntityType entityType);
+static void my_pool_destroy(MyEntityType entityType);
+static bool my_pool_allocate(MyHandle batchHandle, int entityCapacity);
+static void my_pool_release(MyHandle batchHandle);
+static void my_pool_cull(MyEntityType entityType, GLuint instanceBuffer, int instanceOffset, int drawOffset, int drawCount);
+
+static void my_state_use_program(GLuint program);
+static void my_state_bind_vertex_format(GLuint vertexFormat);
+static void my_state_bind_vertex_buffer(MyEntityType entityType, GLuint bindingIndex, GLuint buffer, GLintptr offset, GLsizei stride);
+static void my_state_bind_element_buffer(MyEntityType entityType, GLuint buffer);
+static void my_state_bind_indirect_buffer(GLuint buffer);
+static void my_state_bind_storage_buffer(GLuint bindingIndex, GLuint buffer);
+static void my_state_bind_texture(GLuint unit, GLuint texture);
+static void my_state_set_depth_test(bool depthTest);
+static void my_state_set_blend(bool blend);
+static void my_state_set_blend_func(GLenum blendSource, GLenum blendDestination, GLenum blendSourceAlpha, GLenum blendDestinationAlpha);
+static void my_state_set_depth_mask(bool depthMask);
+static void my_state_set_color(MyColor color);
+static void my_state_forget_program(GLuint program);
+static void my_state_forget_buffer(GLuint buffer);
+static void my_state_forget_texture(GLuint texture);
+static void my_state_forget_vertex_format(GLuint vertexFormat);
+
+static MyHandle my_bucket_create(int width, int height);
+static void my_bucket_destroy(MyHandle bucketHandle);
+static bool my_bucket_allocate(MyHandle bucketHandle, int layerCapacity);
+static MyHandle my_bucket_match(int width, int height);
+static bool my_bucket_add(MyHandle textureHandle);
+static void my_bucket_remove(MyHandle textureHandle);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Variables
 ////////////////////////////////////////////////////////////////////////////////
 
 static MyEngine myEngine = { 0 };
 
+static const GLfloat myQuadVertices[] =
+{
+    -0.5f, -0.5f, 0.0f, 0.0f, 0.0f,
+    0.5f, -0.5f, 0.0f, 1.0f, 0.0f,
+    0.5f, 0.5f, 0.0f, 1.0f, 1.0f,
+    -0.5f, 0.5f, 0.0f, 0.0f, 1.0f
+};
+
+static const GLushort myQuadIndices[] = { 0, 1, 2, 2, 3, 0 };
+
 static const int myKeys[] =
 {
     GLFW_KEY_SPACE,
@@ -419,6 +977,17 @@ bool my_window_create(int x, int y, int width, int height, const char* title)
         my_window_destroy();
         return false;
     }
+#ifdef MY_BINDLESS
+    if (glfwExtensionSupported("GL_ARB_bindless_texture"))
+    {
+        myEngine.getTextureHandle = (MyGetTextureHandle) glfwGetProcAddress("glGetTextureHandleARB");
+        myEngine.makeTextureHandleResident = (MyMakeTextureHandleResident) glfwGetProcAddress("glMakeTextureHandleResidentARB");
+        myEngine.makeTextureHandleNonResident = (MyMakeTextureHandleNonResident) glfwGetProcAddress("glMakeTextureHandleNonResidentARB");
+        myEngine.bindless = myEngine.getTextureHandle && myEngine.makeTextureHandleResident && myEngine.makeTextureHandleNonResident;
+    }
+#endif
+    myEngine.state.depthMask = true;
+    my_state_set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     my_window_set_color(MY_COLOR_BLACK);
     my_window_set_viewport(0.0f, 0.0f, 1.0f, 1.0f);
     my_window_set_vsync(true);
@@ -453,12 +1022,60 @@ bool my_window_create(int x, int y, int width, int height, const char* title)
         my_window_destroy();
         return false;
     }
+    myEngine.animations = calloc(MY_ALLOCATOR_ANIMATION, sizeof(MyAnimation));
+    if (!myEngine.animations)
+    {
+        my_window_destroy();
+        return false;
+    }
+    myEngine.tilemaps = calloc(MY_ALLOCATOR_TILEMAP, sizeof(MyTilemap));
+    if (!myEngine.tilemaps)
+    {
+        my_window_destroy();
+        return false;
+    }
+    myEngine.voxels = calloc(MY_ALLOCATOR_VOXEL, sizeof(MyVoxel));
+    if (!myEngine.voxels)
+    {
+        my_window_destroy();
+        return false;
+    }
+    myEngine.geometries = calloc(MY_ALLOCATOR_GEOMETRY, sizeof(MyGeometry));
+    if (!myEngine.geometries)
+    {
+        my_window_destroy();
+        return false;
+    }
+    myEngine.layers = calloc(MY_ALLOCATOR_LAYER, sizeof(MyLayer));
+    if (!myEngine.layers)
+    {
+        my_window_destroy();
+        return false;
+    }
     myEngine.batches = calloc(MY_ALLOCATOR_BATCH, sizeof(MyBatch));
     if (!myEngine.batches)
     {
         my_window_destroy();
         return false;
     }
+    myEngine.batchTable = calloc(MY_ALLOCATOR_BATCH_TABLE, sizeof(MyHandle));
+    if (!myEngine.batchTable)
+    {
+        my_window_destroy();
+        return false;
+    }
+    myEngine.buckets = calloc(MY_ALLOCATOR_BUCKET, sizeof(MyBucket));
+    if (!myEngine.buckets)
+    {
+        my_window_destroy();
+        return false;
+    }
+    myEngine.dirtyEntities = calloc(MY_ALLOCATOR_ENTITY, sizeof(MyHandle));
+    if (!myEngine.dirtyEntities)
+    {
+        my_window_destroy();
+        return false;
+    }
     glCreateBuffers(1, &myEngine.cameraBuffer);
     if (!myEngine.cameraBuffer)
     {
@@ -467,13 +1084,30 @@ bool my_window_create(int x, int y, int width, int height, const char* title)
     }
     glNamedBufferStorage(myEngine.cameraBuffer, MY_CAPACITY_CAMERA, NULL, GL_DYNAMIC_STORAGE_BIT);
     glBindBufferBase(GL_UNIFORM_BUFFER, MY_BUFFER_CAMERA, myEngine.cameraBuffer);
+    for (int i = 0; i < MY_ENTITY_TYPE_COUNT; i++)
+    {
+        if (!my_pool_create(i))
+        {
+            my_window_destroy();
+            return false;
+        }
+    }
     myEngine.renderMask |= GL_COLOR_BUFFER_BIT;
     myEngine.entityCapacity = MY_ALLOCATOR_ENTITY;
     myEngine.textureCapacity = MY_ALLOCATOR_TEXTURE;
     myEngine.shaderCapacity = MY_ALLOCATOR_SHADER;
     myEngine.cameraCapacity = MY_ALLOCATOR_CAMERA;
     myEngine.clockCapacity = MY_ALLOCATOR_CLOCK;
+    myEngine.animationCapacity = MY_ALLOCATOR_ANIMATION;
+    myEngine.tilemapCapacity = MY_ALLOCATOR_TILEMAP;
+    myEngine.voxelCapacity = MY_ALLOCATOR_VOXEL;
+    myEngine.geometryCapacity = MY_ALLOCATOR_GEOMETRY;
+    myEngine.layerCapacity = MY_ALLOCATOR_LAYER;
     myEngine.batchCapacity = MY_ALLOCATOR_BATCH;
+    myEngine.batchTableCapacity = MY_ALLOCATOR_BATCH_TABLE;
+    myEngine.bucketCapacity = MY_ALLOCATOR_BUCKET;
+    myEngine.dirtyCapacity = MY_ALLOCATOR_ENTITY;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &myEngine.layerLimit);
     stbi_set_flip_vertically_on_load(true);
     if (!my_texture_create(MY_PATH_ASSETS "/images/pixel.png", 1))
     {
@@ -485,11 +1119,41 @@ bool my_window_create(int x, int y, int width, int height, const char* title)
         my_window_destroy();
         return false;
     }
-    // if (!my_shader_create(MY_PATH_ASSETS "/shaders/vertex/mesh.glsl", MY_PATH_ASSETS "/shaders/fragment/mesh.glsl"))
-    // {
-    //     my_window_destroy();
-    //     return false;
-    // }
+    myEngine.cullProgram = my_shader_compute(MY_PATH_ASSETS "/shaders/compute/cull.glsl");
+    if (!myEngine.cullProgram)
+    {
+        my_window_destroy();
+        return false;
+    }
+    if (!my_shader_create(MY_PATH_ASSETS "/shaders/vertex/mesh.glsl", MY_PATH_ASSETS "/shaders/fragment/mesh.glsl"))
+    {
+        my_window_destroy();
+        return false;
+    }
+    if (!my_geometry_quad())
+    {
+        my_window_destroy();
+        return false;
+    }
+    if (!my_geometry_cube())
+    {
+        my_window_destroy();
+        return false;
+    }
+    if (!my_geometry_sphere())
+    {
+        my_window_destroy();
+        return false;
+    }
+    if (!my_geometry_cylinder())
+    {
+        my_window_destroy();
+        return false;
+    }
+    for (int i = 1; i < myEngine.geometryCapacity; i++)
+    {
+        myEngine.geometries[i].baseCount = myEngine.geometries[i].referenceCount;
+    }
     if (!my_camera_create_orthographic(0.0f, (float) width, 0.0f, (float) height, -1.0f, 1.0f))
     {
         my_window_destroy();
@@ -513,13 +1177,38 @@ bool my_window_create(int x, int y, int width, int height, const char* title)
 
 void my_window_destroy(void)
 {
+    if (myEngine.voxelRunning)
+    {
+        my_voxel_stop();
+    }
     for (int i = 1; i < myEngine.batchCapacity; i++)
     {
-        if (myEngine.entities[i].batchHandle)
+        if (myEngine.batches[i].batchHandle)
         {
             my_batch_destroy(i);
         }
     }
+    for (int i = 1; i < myEngine.animationCapacity; i++)
+    {
+        if (myEngine.animations[i].animationHandle)
+        {
+            my_animation_destroy(i);
+        }
+    }
+    for (int i = 1; i < myEngine.tilemapCapacity; i++)
+    {
+        if (myEngine.tilemaps[i].tilemapHandle)
+        {
+            my_tilemap_destroy(i);
+        }
+    }
+    for (int i = 1; i < myEngine.voxelCapacity; i++)
+    {
+        if (myEngine.voxels[i].voxelHandle)
+        {
+            my_voxel_destroy(i);
+        }
+    }
     for (int i = 1; i < myEngine.entityCapacity; i++)
     {
         if (myEngine.entities[i].entityHandle)
@@ -527,6 +1216,13 @@ void my_window_destroy(void)
             my_entity_destroy(i);
         }
     }
+    for (int i = 1; i < myEngine.layerCapacity; i++)
+    {
+        if (myEngine.layers[i].layerHandle)
+        {
+            my_layer_destroy(i);
+        }
+    }
     for (int i = 1; i < myEngine.textureCapacity; i++)
     {
         if (myEngine.textures[i].textureHandle)
@@ -541,6 +1237,13 @@ void my_window_destroy(void)
             my_shader_destroy(i);
         }
     }
+    for (int i = 1; i < myEngine.bucketCapacity; i++)
+    {
+        if (myEngine.buckets[i].bucketHandle)
+        {
+            my_bucket_destroy(i);
+        }
+    }
     for (int i = 1; i < myEngine.cameraCapacity; i++)
     {
         if (myEngine.cameras[i].cameraHandle)
@@ -575,14 +1278,116 @@ void my_window_destroy(void)
     {
         free(myEngine.clocks);
     }
+    if (myEngine.animations)
+    {
+        free(myEngine.animations);
+    }
+    if (myEngine.tilemaps)
+    {
+        free(myEngine.tilemaps);
+    }
+    if (myEngine.voxels)
+    {
+        free(myEngine.voxels);
+    }
+    if (myEngine.geometries)
+    {
+        for (int i = 1; i < myEngine.geometryCapacity; i++)
+        {
+            if (myEngine.geometries[i].data)
+            {
+                free(myEngine.geometries[i].data);
+            }
+        }
+        free(myEngine.geometries);
+    }
+    if (myEngine.layers)
+    {
+        free(myEngine.layers);
+    }
+    if (myEngine.playingHandles)
+    {
+        free(myEngine.playingHandles);
+    }
+    if (myEngine.playingClocks)
+    {
+        free(myEngine.playingClocks);
+    }
+    if (myEngine.playingTimes)
+    {
+        free(myEngine.playingTimes);
+    }
+    if (myEngine.playingDurations)
+    {
+        free(myEngine.playingDurations);
+    }
     if (myEngine.batches)
     {
         free(myEngine.batches);
     }
+    if (myEngine.batchTable)
+    {
+        free(myEngine.batchTable);
+    }
+    if (myEngine.buckets)
+    {
+        free(myEngine.buckets);
+    }
+    if (myEngine.dirtyEntities)
+    {
+        free(myEngine.dirtyEntities);
+    }
+    if (myEngine.sortItems)
+    {
+        free(myEngine.sortItems);
+    }
+    if (myEngine.sortScratch)
+    {
+        free(myEngine.sortScratch);
+    }
+    for (int i = 0; i < MY_ENTITY_TYPE_COUNT; i++)
+    {
+        my_pool_destroy(i);
+    }
     if (myEngine.cameraBuffer)
     {
         glDeleteBuffers(1, &myEngine.cameraBuffer);
     }
+    if (myEngine.cullProgram)
+    {
+        glDeleteProgram(myEngine.cullProgram);
+    }
+    if (myEngine.residentBuffer)
+    {
+        glDeleteBuffers(1, &myEngine.residentBuffer);
+    }
+    if (myEngine.frameBuffer)
+    {
+        glDeleteBuffers(1, &myEngine.frameBuffer);
+    }
+    if (myEngine.layerFormat)
+    {
+        glDeleteVertexArrays(1, &myEngine.layerFormat);
+    }
+    if (myEngine.sceneFramebuffer)
+    {
+        glDeleteFramebuffers(1, &myEngine.sceneFramebuffer);
+    }
+    if (myEngine.sceneColor)
+    {
+        glDeleteRenderbuffers(1, &myEngine.sceneColor);
+    }
+    if (myEngine.sceneDepth)
+    {
+        glDeleteRenderbuffers(1, &myEngine.sceneDepth);
+    }
+    for (int i = 0; i < MY_CAPACITY_RING; i++)
+    {
+        if (myEngine.ringFences[i])
+        {
+            glDeleteSync(myEngine.ringFences[i]);
+        }
+    }
     if (myEngine.window)
     {
         glfwDestroyWindow(myEngine.window);
@@ -635,12 +1440,13 @@ bool my_window_prepare(void)
     const float windowTime = (float) glfwGetTime();
     for (int i = 1; i < myEngine.clockCapacity; i++)
     {
-        if (myEngine.clocks[i].clockHandle)
+        if (myEngine.clocks[i].clockHandle && myEngine.clocks[i].active)
         {
             const float frameTime = windowTime - myEngine.clocks[i].lastTime;
             myEngine.clocks[i].lastTime = windowTime;
             myEngine.clocks[i].totalTime += frameTime;
             myEngine.clocks[i].intervalTime += frameTime;
+            myEngine.clocks[i].frameTime = frameTime;
             if (myEngine.clocks[i].callback)
             {
                 if (myEngine.clocks[i].intervalTime > myEngine.clocks[i].interval)
@@ -651,33 +1457,124 @@ bool my_window_prepare(void)
             }
         }
     }
-    myEngine.frameCount++;
-    return true;
+    for (int i = myEngine.playingCount - 1; i >= 0; i--)
+    {
+        myEngine.playingTimes[i] += myEngine.clocks[myEngine.playingClocks[i]].frameTime;
+        if (myEngine.playingTimes[i] >= myEngine.playingDurations[i])
+        {
+            my_animation_advance(myEngine.playingHandles[i]);
+        }
+    }
+    myEngine.frameCount++;
+    return true;
 }
 
 void my_window_render(void)
 {
-    if (myEngine.cameras[myEngine.cameraHandle].dirty)
+    const bool cameraDirty = myEngine.cameras[myEngine.cameraHandle].dirty;
+    for (int i = 1; i < myEngine.layerCapacity; i++)
+    {
+        if (myEngine.layers[i].layerHandle && (myEngine.layers[i].cameraHandle ? myEngine.cameras[myEngine.layers[i].cameraHandle].dirty : cameraDirty))
+        {
+            myEngine.layers[i].dirty = true;
+        }
+    }
+    if (cameraDirty)
     {
         my_camera_update(myEngine.cameraHandle);
     }
+    if (myEngine.ringFences[myEngine.ringIndex])
+    {
+        while (glClientWaitSync(myEngine.ringFences[myEngine.ringIndex], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED);
+        glDeleteSync(myEngine.ringFences[myEngine.ringIndex]);
+        myEngine.ringFences[myEngine.ringIndex] = NULL;
+    }
+    for (int i = 0; i < myEngine.dirtyCount; i++)
+    {
+        if (myEngine.entities[myEngine.dirtyEntities[i]].dirty)
+        {
+            my_entity_update(myEngine.dirtyEntities[i]);
+        }
+    }
+    myEngine.dirtyCount = 0;
+    if (!my_batch_scratch(myEngine.batchCount))
+    {
+        return;
+    }
+    int batchCount = 0;
     for (int i = 1; i < myEngine.batchCapacity; i++)
     {
         if (myEngine.batches[i].batchHandle)
         {
-            const MyHandle shaderHandle = myEngine.batches[i].shaderHandle;
-            const MyHandle textureHandle = myEngine.batches[i].textureHandle;
-            glBindVertexArray(myEngine.batches[i].vertexFormat);
-            glVertexArrayVertexBuffer(myEngine.batches[i].vertexFormat, MY_BUFFER_ENTITY_VERTEX, myEngine.batches[i].vertexBuffer, 0, sizeof(GLfloat) * 5);
-            glVertexArrayVertexBuffer(myEngine.batches[i].vertexFormat, MY_BUFFER_ENTITY_TRANSFORM, myEngine.batches[i].transformBuffer, 0, sizeof(MyTransform));
-            glVertexArrayElementBuffer(myEngine.batches[i].vertexFormat, myEngine.batches[i].indexBuffer);
-            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, myEngine.batches[i].indirectBuffer);
-            glUseProgram(myEngine.shaders[shaderHandle].program);
-            glProgramUniform1i(myEngine.shaders[shaderHandle].program, MY_UNIFORM_ENTITY_TEXTURE, 0);
-            glBindTextureUnit(MY_SAMPLER_ENTITY, myEngine.textures[textureHandle].texture);
-            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_SHORT, NULL, myEngine.batches[i].entityCount, 0);
+            const MyHandle layerHandle = myEngine.batches[i].layerHandle;
+            if ((cameraDirty || !myEngine.batches[i].sorted || (layerHandle && myEngine.layers[layerHandle].dirty)) && !my_batch_order(i))
+            {
+                continue;
+            }
+            myEngine.sortItems[batchCount] = (MySortItem) { my_batch_key(i), i };
+            batchCount++;
+        }
+    }
+    my_batch_sort(myEngine.sortItems, batchCount);
+    for (int i = 0; i < MY_ENTITY_TYPE_COUNT; i++)
+    {
+        myEngine.pools[i].drawCount = 0;
+    }
+    for (int j = 0; j < batchCount; j++)
+    {
+        const MyHandle layerHandle = myEngine.batches[myEngine.sortItems[j].value].layerHandle;
+        if (layerHandle && !myEngine.layers[layerHandle].dirty)
+        {
+            continue;
+        }
+        if (myEngine.culling && !layerHandle && myEngine.batches[myEngine.sortItems[j].value].entityType != MY_ENTITY_TYPE_MESH)
+        {
+            my_batch_clip(myEngine.sortItems[j].value);
+        }
+        my_batch_upload(myEngine.sortItems[j].value);
+    }
+    for (int i = 1; i < myEngine.layerCapacity; i++)
+    {
+        if (myEngine.layers[i].layerHandle && myEngine.layers[i].dirty)
+        {
+            my_layer_render(i, batchCount);
         }
     }
+    my_layer_composite(false);
+    for (int i = 1; i < myEngine.tilemapCapacity; i++)
+    {
+        if (myEngine.tilemaps[i].tilemapHandle && myEngine.tilemaps[i].visible)
+        {
+            my_tilemap_draw(i);
+        }
+    }
+    if (myEngine.voxelRunning)
+    {
+        my_voxel_collect();
+    }
+    for (int i = 1; i < myEngine.voxelCapacity; i++)
+    {
+        if (myEngine.voxels[i].voxelHandle)
+        {
+            my_voxel_dispatch(i);
+            if (myEngine.voxels[i].visible)
+            {
+                my_voxel_draw(i);
+            }
+        }
+    }
+    my_batch_draw(batchCount, MY_INVALID_HANDLE);
+    my_layer_composite(true);
+    if (myEngine.sceneFramebuffer)
+    {
+        my_window_present();
+    }
+    myEngine.ringFences[myEngine.ringIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    myEngine.ringIndex = (myEngine.ringIndex + 1) % MY_CAPACITY_RING;
+    myEngine.state.frameIssuedCount = myEngine.state.issuedCount;
+    myEngine.state.frameAvoidedCount = myEngine.state.avoidedCount;
+    myEngine.state.issuedCount = 0;
+    myEngine.state.avoidedCount = 0;
 }
 
 void my_window_set_position(int x, int y)
@@ -701,8 +1598,7 @@ void my_window_set_title(const char* title)
 
 void my_window_set_color(MyColor color)
 {
-    color = my_color_clamp(color);
-    glClearColor(color.red, color.green, color.blue, color.alpha);
+    my_state_set_color(my_color_clamp(color));
 }
 
 void my_window_set_viewport(float x, float y, float width, float height)
@@ -711,7 +1607,55 @@ void my_window_set_viewport(float x, float y, float width, float height)
     myEngine.viewportY = y;
     myEngine.viewportWidth = width;
     myEngine.viewportHeight = height;
-    glViewport(myEngine.windowWidth * x, myEngine.windowHeight * y, myEngine.windowWidth * width, myEngine.windowHeight * height);
+    const int targetWidth = myEngine.sceneFramebuffer ? myEngine.sceneWidth : myEngine.windowWidth;
+    const int targetHeight = myEngine.sceneFramebuffer ? myEngine.sceneHeight : myEngine.windowHeight;
+    glViewport(targetWidth * x, targetHeight * y, targetWidth * width, targetHeight * height);
+}
+
+bool my_window_set_resolution(int width, int height)
+{
+    if (myEngine.sceneFramebuffer)
+    {
+        glDeleteFramebuffers(1, &myEngine.sceneFramebuffer);
+        myEngine.sceneFramebuffer = 0;
+    }
+    if (myEngine.sceneColor)
+    {
+        glDeleteRenderbuffers(1, &myEngine.sceneColor);
+        myEngine.sceneColor = 0;
+    }
+    if (myEngine.sceneDepth)
+    {
+        glDeleteRenderbuffers(1, &myEngine.sceneDepth);
+        myEngine.sceneDepth = 0;
+    }
+    myEngine.sceneWidth = 0;
+    myEngine.sceneHeight = 0;
+    if (width > 0 && height > 0)
+    {
+        glCreateFramebuffers(1, &myEngine.sceneFramebuffer);
+        glCreateRenderbuffers(1, &myEngine.sceneColor);
+        glCreateRenderbuffers(1, &myEngine.sceneDepth);
+        if (!myEngine.sceneFramebuffer || !myEngine.sceneColor || !myEngine.sceneDepth)
+        {
+            my_window_set_resolution(0, 0);
+            return false;
+        }
+        glNamedRenderbufferStorage(myEngine.sceneColor, GL_RGBA8, width, height);
+        glNamedRenderbufferStorage(myEngine.sceneDepth, GL_DEPTH_COMPONENT24, width, height);
+        glNamedFramebufferRenderbuffer(myEngine.sceneFramebuffer, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, myEngine.sceneColor);
+        glNamedFramebufferRenderbuffer(myEngine.sceneFramebuffer, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, myEngine.sceneDepth);
+        if (glCheckNamedFramebufferStatus(myEngine.sceneFramebuffer, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            my_window_set_resolution(0, 0);
+            return false;
+        }
+        myEngine.sceneWidth = width;
+        myEngine.sceneHeight = height;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, myEngine.sceneFramebuffer);
+    my_window_set_viewport(myEngine.viewportX, myEngine.viewportY, myEngine.viewportWidth, myEngine.viewportHeight);
+    return true;
 }
 
 void my_window_set_vsync(bool vsync)
@@ -724,13 +1668,28 @@ void my_window_set_depth(bool depth)
     if (depth)
     {
         myEngine.renderMask |= GL_DEPTH_BUFFER_BIT;
-        glEnable(GL_DEPTH_TEST);
+        my_state_set_depth_test(true);
     }
     else
     {
         myEngine.renderMask &= ~GL_DEPTH_BUFFER_BIT;
-        glDisable(GL_DEPTH_TEST);
+        my_state_set_depth_test(false);
+    }
+}
+
+void my_window_set_culling(bool culling)
+{
+    if (myEngine.culling && !culling)
+    {
+        for (int i = 1; i < myEngine.batchCapacity; i++)
+        {
+            if (myEngine.batches[i].batchHandle)
+            {
+                my_batch_touch(i, 0, myEngine.batches[i].entityCount - 1);
+            }
+        }
     }
+    myEngine.culling = culling;
 }
 
 void my_window_set_cursor(bool cursor)
@@ -765,6 +1724,12 @@ int my_window_get_frame_rate(void)
     return myEngine.frameRate;
 }
 
+void my_window_get_state_calls(int* issued, int* avoided)
+{
+    *issued = myEngine.state.frameIssuedCount;
+    *avoided = myEngine.state.frameAvoidedCount;
+}
+
 static void my_window_position_callback(GLFWwindow* window, int x, int y)
 {
     myEngine.windowX = x;
@@ -775,7 +1740,22 @@ static void my_window_size_callback(GLFWwindow* window, int width, int height)
 {
     myEngine.windowWidth = width;
     myEngine.windowHeight = height;
-    glViewport(myEngine.windowWidth * myEngine.viewportX, myEngine.windowHeight * myEngine.viewportY, width * myEngine.viewportWidth, height * myEngine.viewportHeight);
+    my_window_set_viewport(myEngine.viewportX, myEngine.viewportY, myEngine.viewportWidth, myEngine.viewportHeight);
+}
+
+static void my_window_present(void)
+{
+    const int sceneWidth = myEngine.sceneWidth;
+    const int sceneHeight = myEngine.sceneHeight;
+    int scale = myEngine.windowWidth / sceneWidth < myEngine.windowHeight / sceneHeight ? myEngine.windowWidth / sceneWidth : myEngine.windowHeight / sceneHeight;
+    if (scale < 1)
+    {
+        scale = 1;
+    }
+    const int x = (myEngine.windowWidth - sceneWidth * scale) / 2;
+    const int y = (myEngine.windowHeight - sceneHeight * scale) / 2;
+    glClearNamedFramebufferfv(0, GL_COLOR, 0, (const GLfloat[]) { 0.0f, 0.0f, 0.0f, 1.0f });
+    glBlitNamedFramebuffer(myEngine.sceneFramebuffer, 0, 0, 0, sceneWidth, sceneHeight, x, y, x + sceneWidth * scale, y + sceneHeight * scale, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -784,101 +1764,248 @@ static void my_window_size_callback(GLFWwindow* window, int width, int height)
 
 MyHandle my_entity_create_sprite(float width, float height)
 {
-    MyHandle entityHandle = MY_INVALID_HANDLE;
-    for (int i = 1; i < myEngine.entityCapacity; i++)
+    const MyHandle entityHandle = my_entity_allocate();
+    if (!entityHandle)
     {
-        if (!myEngine.entities[i].entityHandle)
-        {
-            entityHandle = i;
-            break;
-        }
+        return MY_INVALID_HANDLE;
+    }
+    myEngine.entities[entityHandle].entityHandle = entityHandle;
+    myEngine.entities[entityHandle].textureHandle = MY_DEFAULT_TEXTURE;
+    myEngine.entities[entityHandle].shaderHandle = MY_DEFAULT_SHADER_SPRITE;
+    my_texture_link(entityHandle);
+    my_shader_link(entityHandle);
+    myEngine.entities[entityHandle].type = MY_ENTITY_TYPE_SPRITE;
+    myEngine.entities[entityHandle].indexSize = sizeof(GLushort);
+    myEngine.entities[entityHandle].scale = (MyVector) { 1.0f, 1.0f, 1.0f };
+    myEngine.entities[entityHandle].transform = MY_TRANSFORM_IDENTITY;
+    myEngine.entities[entityHandle].width = width;
+    myEngine.entities[entityHandle].height = height;
+    return entityHandle;
+}
+
+MyHandle my_entity_create_mesh(MyHandle geometryHandle)
+{
+    if (geometryHandle <= 0 || geometryHandle >= myEngine.geometryCapacity || !myEngine.geometries[geometryHandle].geometryHandle)
+    {
+        return MY_INVALID_HANDLE;
     }
+    const MyHandle entityHandle = my_entity_allocate();
     if (!entityHandle)
     {
-        MyEntity* entities = realloc(myEngine.entities, (myEngine.entityCapacity + MY_ALLOCATOR_ENTITY) * sizeof(MyEntity));
-        if (!entities)
+        return MY_INVALID_HANDLE;
+    }
+    myEngine.entities[entityHandle].entityHandle = entityHandle;
+    myEngine.entities[entityHandle].textureHandle = MY_DEFAULT_TEXTURE;
+    myEngine.entities[entityHandle].shaderHandle = MY_DEFAULT_SHADER_MESH;
+    my_texture_link(entityHandle);
+    my_shader_link(entityHandle);
+    myEngine.entities[entityHandle].type = MY_ENTITY_TYPE_MESH;
+    myEngine.entities[entityHandle].geometryHandle = geometryHandle;
+    myEngine.entities[entityHandle].indexSize = myEngine.geometries[geometryHandle].indexSize;
+    myEngine.entities[entityHandle].boundsCenter = myEngine.geometries[geometryHandle].boundsCenter;
+    myEngine.entities[entityHandle].boundsRadius = myEngine.geometries[geometryHandle].boundsRadius;
+    myEngine.entities[entityHandle].scale = (MyVector) { 1.0f, 1.0f, 1.0f };
+    myEngine.entities[entityHandle].transform = MY_TRANSFORM_IDENTITY;
+    myEngine.geometries[geometryHandle].referenceCount++;
+    return entityHandle;
+}
+
+MyHandle my_entity_bake(const MyHandle* entityHandles, int entityCount)
+{
+    if (!entityHandles || entityCount <= 0)
+    {
+        return MY_INVALID_HANDLE;
+    }
+    bool* entitySeen = calloc(myEngine.entityCapacity, sizeof(bool));
+    if (!entitySeen)
+    {
+        return MY_INVALID_HANDLE;
+    }
+    for (int i = 0; i < entityCount; i++)
+    {
+        const MyHandle entityHandle = entityHandles[i];
+        if (entityHandle <= 0 || entityHandle >= myEngine.entityCapacity || !myEngine.entities[entityHandle].entityHandle || entitySeen[entityHandle])
         {
+            free(entitySeen);
             return MY_INVALID_HANDLE;
         }
-        entityHandle = myEngine.entityCapacity;
-        myEngine.entities = entities;
-        myEngine.entityCapacity += MY_ALLOCATOR_ENTITY;
+        entitySeen[entityHandle] = true;
+    }
+    free(entitySeen);
+    const MyEntity* first = &myEngine.entities[entityHandles[0]];
+    const MyHandle textureHandle = first->textureHandle;
+    bool visible = false;
+    for (int i = 0; i < entityCount; i++)
+    {
+        if (myEngine.entities[entityHandles[i]].type != MY_ENTITY_TYPE_SPRITE ||
+            myEngine.entities[entityHandles[i]].textureHandle != textureHandle ||
+            myEngine.entities[entityHandles[i]].shaderHandle != MY_DEFAULT_SHADER_SPRITE ||
+            myEngine.entities[entityHandles[i]].layerHandle != first->layerHandle ||
+            myEngine.entities[entityHandles[i]].sortMode != first->sortMode ||
+            myEngine.entities[entityHandles[i]].sortLayer != first->sortLayer)
+        {
+            return MY_INVALID_HANDLE;
+        }
+        visible |= myEngine.entities[entityHandles[i]].batchHandle != MY_INVALID_HANDLE;
+    }
+    const int vertexCount = entityCount * 4;
+    const int indexCount = entityCount * 6;
+    const int indexSize = vertexCount > USHRT_MAX ? sizeof(GLuint) : sizeof(GLushort);
+    float* vertices = malloc(vertexCount * 8 * sizeof(float));
+    unsigned char* indices = malloc(indexCount * indexSize);
+    if (!vertices || !indices)
+    {
+        free(vertices);
+        free(indices);
+        return MY_INVALID_HANDLE;
+    }
+    for (int i = 0; i < entityCount; i++)
+    {
+        const MyEntity* entity = &myEngine.entities[entityHandles[i]];
+        const int frameIndex = entity->frameIndex >= 0 && entity->frameIndex < myEngine.textures[textureHandle].frameCount ? entity->frameIndex : 0;
+        const MyFrame frame = my_texture_frame(textureHandle, frameIndex);
+        const float width = entity->width * entity->scale.x;
+        const float height = entity->height * entity->scale.y;
+        const float cosRotation = cosf(entity->rotation.z * MY_FLOAT_RADIANS);
+        const float sinRotation = sinf(entity->rotation.z * MY_FLOAT_RADIANS);
+        for (int j = 0; j < 4; j++)
+        {
+            const GLfloat* corner = myQuadVertices + j * 5;
+            const MyVector position =
+            {
+                entity->position.x + corner[0] * cosRotation * width + corner[1] * sinRotation * height,
+                entity->position.y - corner[0] * sinRotation * width + corner[1] * cosRotation * height,
+                entity->position.z + corner[2]
+            };
+            const float u = (frame.x + corner[3] * frame.width) / (float) USHRT_MAX;
+            const float v = (frame.y + corner[4] * frame.height) / (float) USHRT_MAX;
+            my_geometry_vertex(vertices, i * 4 + j, position, (MyVector) { 0.0f, 0.0f, 1.0f }, u, v);
+        }
+        for (int j = 0; j < 6; j++)
+        {
+            const GLuint index = i * 4 + myQuadIndices[j];
+            if (indexSize == sizeof(GLuint))
+            {
+                ((GLuint*) indices)[i * 6 + j] = index;
+            }
+            else
+            {
+                ((GLushort*) indices)[i * 6 + j] = (GLushort) index;
+            }
+        }
     }
-    myEngine.entities[entityHandle].vertices = calloc(20, sizeof(float));
-    if (!myEngine.entities[entityHandle].vertices)
+    const MyHandle geometryHandle = my_geometry_create(vertices, vertexCount, indices, indexCount, indexSize);
+    free(vertices);
+    free(indices);
+    if (!geometryHandle)
     {
-        my_entity_destroy(entityHandle);
         return MY_INVALID_HANDLE;
     }
-    myEngine.entities[entityHandle].indices = calloc(6, sizeof(GLushort));
-    if (!myEngine.entities[entityHandle].indices)
+    const MyHandle entityHandle = my_entity_create_mesh(geometryHandle);
+    my_geometry_destroy(geometryHandle);
+    if (!entityHandle)
     {
-        my_entity_destroy(entityHandle);
         return MY_INVALID_HANDLE;
     }
-    myEngine.entities[entityHandle].entityHandle = entityHandle;
-    myEngine.entities[entityHandle].textureHandle = MY_DEFAULT_TEXTURE;
-    myEngine.entities[entityHandle].shaderHandle = MY_DEFAULT_SHADER_SPRITE;
-    const GLfloat vertices[] =
+    my_entity_set_texture(entityHandle, textureHandle);
+    myEngine.entities[entityHandle].stationary = true;
+    myEngine.entities[entityHandle].layerHandle = myEngine.entities[entityHandles[0]].layerHandle;
+    myEngine.entities[entityHandle].sortMode = myEngine.entities[entityHandles[0]].sortMode;
+    myEngine.entities[entityHandle].sortLayer = myEngine.entities[entityHandles[0]].sortLayer;
+    myEngine.entities[entityHandle].sortKey = myEngine.entities[entityHandles[0]].sortKey;
+    for (int i = 0; i < entityCount; i++)
+    {
+        my_entity_destroy(entityHandles[i]);
+    }
+    if (visible)
     {
-        -width * 0.5f, -height * 0.5f, 0.0f, 0.0f, 0.0f,
-        width * 0.5f, -height * 0.5f, 0.0f, 1.0f, 0.0f,
-        width * 0.5f, height * 0.5f, 0.0f, 1.0f, 1.0f,
-        -width * 0.5f, height * 0.5f, 0.0f, 0.0f, 1.0f
-    };
-    const GLushort indices[] = { 0, 1, 2, 2, 3, 0 };
-    memcpy(myEngine.entities[entityHandle].vertices, vertices, sizeof(vertices));
-    memcpy(myEngine.entities[entityHandle].indices, indices, sizeof(indices));
-    myEngine.entities[entityHandle].type = MY_ENTITY_TYPE_SPRITE;
-    myEngine.entities[entityHandle].scale = (MyVector) { 1.0f, 1.0f, 1.0f };
-    myEngine.entities[entityHandle].transform = MY_TRANSFORM_IDENTITY;
-    myEngine.entities[entityHandle].vertexCount = 4;
-    myEngine.entities[entityHandle].vertexSize = sizeof(GLfloat) * 5;
-    myEngine.entities[entityHandle].indexCount = 6;
+        my_entity_set_visible(entityHandle, true);
+    }
     return entityHandle;
 }
 
-MyHandle my_entity_create_mesh(void)
+bool my_entity_reserve(MyHandle entityHandle, int entityCount)
 {
-
+    if (entityHandle <= 0 || entityHandle >= myEngine.entityCapacity || !myEngine.entities[entityHandle].entityHandle || entityCount < 0)
+    {
+        return false;
+    }
+    MyHandle batchHandle = myEngine.entities[entityHandle].batchHandle;
+    if (!batchHandle)
+    {
+        batchHandle = my_batch_match(entityHandle);
+    }
+    if (!batchHandle)
+    {
+        return true;
+    }
+    return my_batch_reserve(batchHandle, entityCount);
 }
 
 void my_entity_destroy(MyHandle entityHandle)
 {
+    if (myEngine.entities[entityHandle].animationHandle)
+    {
+        my_animation_destroy(myEngine.entities[entityHandle].animationHandle);
+    }
     my_entity_set_visible(entityHandle, false);
+    my_texture_unlink(entityHandle);
+    my_shader_unlink(entityHandle);
+    if (myEngine.entities[entityHandle].geometryHandle)
+    {
+        my_geometry_release(myEngine.entities[entityHandle].geometryHandle);
+    }
     myEngine.entities[entityHandle] = (MyEntity) { 0 };
 }
 
 void my_entity_move(MyHandle entityHandle, MyVector distance)
 {
     myEngine.entities[entityHandle].position = my_vector_add(myEngine.entities[entityHandle].position, distance);
-    myEngine.entities[entityHandle].transform = my_transform_compose(myEngine.entities[entityHandle].position, myEngine.entities[entityHandle].scale, myEngine.entities[entityHandle].rotation);
-    if (myEngine.entities[entityHandle].batchHandle)
-    {
-        const MyHandle batchHandle = myEngine.entities[entityHandle].batchHandle;
-        glNamedBufferSubData(myEngine.batches[batchHandle].transformBuffer, myEngine.entities[entityHandle].entityIndex * sizeof(MyTransform), sizeof(MyTransform), &myEngine.entities[entityHandle].transform);
-    }
+    my_entity_mark(entityHandle);
 }
 
 void my_entity_scale(MyHandle entityHandle, MyVector scale)
 {
     myEngine.entities[entityHandle].scale = my_vector_scale(myEngine.entities[entityHandle].scale, scale);
-    myEngine.entities[entityHandle].transform = my_transform_compose(myEngine.entities[entityHandle].position, myEngine.entities[entityHandle].scale, myEngine.entities[entityHandle].rotation);
-    if (myEngine.entities[entityHandle].batchHandle)
-    {
-        const MyHandle batchHandle = myEngine.entities[entityHandle].batchHandle;
-        glNamedBufferSubData(myEngine.batches[batchHandle].transformBuffer, myEngine.entities[entityHandle].entityIndex * sizeof(MyTransform), sizeof(MyTransform), &myEngine.entities[entityHandle].transform);
-    }
+    my_entity_mark(entityHandle);
 }
 
 void my_entity_rotate(MyHandle entityHandle, MyVector rotation)
 {
     myEngine.entities[entityHandle].rotation = my_vector_add(myEngine.entities[entityHandle].rotation, rotation);
-    myEngine.entities[entityHandle].transform = my_transform_compose(myEngine.entities[entityHandle].position, myEngine.entities[entityHandle].scale, myEngine.entities[entityHandle].rotation);
-    if (myEngine.entities[entityHandle].batchHandle)
+    my_entity_mark(entityHandle);
+}
+
+void my_entity_set_texture(MyHandle entityHandle, MyHandle textureHandle)
+{
+    const MyHandle bucketHandle = myEngine.textures[myEngine.entities[entityHandle].textureHandle].bucketHandle;
+    const bool transparent = myEngine.textures[myEngine.entities[entityHandle].textureHandle].transparent;
+    if (myEngine.entities[entityHandle].batchHandle &&
+        (myEngine.textures[textureHandle].bucketHandle != bucketHandle || myEngine.textures[textureHandle].transparent != transparent))
+    {
+        my_batch_remove(entityHandle);
+        my_texture_unlink(entityHandle);
+        myEngine.entities[entityHandle].textureHandle = textureHandle;
+        my_texture_link(entityHandle);
+        my_batch_add(entityHandle);
+        return;
+    }
+    my_texture_unlink(entityHandle);
+    myEngine.entities[entityHandle].textureHandle = textureHandle;
+    my_texture_link(entityHandle);
+    my_entity_mark(entityHandle);
+}
+
+void my_entity_set_frame(MyHandle entityHandle, int frameIndex)
+{
+    myEngine.entities[entityHandle].frameIndex = frameIndex;
+    const MyHandle batchHandle = myEngine.entities[entityHandle].batchHandle;
+    if (batchHandle && myEngine.entities[entityHandle].type == MY_ENTITY_TYPE_SPRITE)
     {
-        const MyHandle batchHandle = myEngine.entities[entityHandle].batchHandle;
-        glNamedBufferSubData(myEngine.batches[batchHandle].transformBuffer, myEngine.entities[entityHandle].entityIndex * sizeof(MyTransform), sizeof(MyTransform), &myEngine.entities[entityHandle].transform);
+        const int entityIndex = myEngine.entities[entityHandle].entityIndex;
+        MySpriteInstance* spriteInstance = (MySpriteInstance*) (myEngine.batches[batchHandle].instances + entityIndex * myEngine.batches[batchHandle].instanceSize);
+        spriteInstance->frame = my_texture_slot(myEngine.entities[entityHandle].textureHandle, frameIndex);
+        my_batch_touch(batchHandle, entityIndex, entityIndex);
     }
 }
 
@@ -894,37 +2021,82 @@ void my_entity_set_visible(MyHandle entityHandle, bool visible)
     }
 }
 
-void my_entity_set_position(MyHandle entityHandle, MyVector position)
+void my_entity_set_static(MyHandle entityHandle, bool stationary)
 {
-    myEngine.entities[entityHandle].position = my_vector_add(myEngine.entities[entityHandle].position, position);
-    myEngine.entities[entityHandle].transform = my_transform_compose(myEngine.entities[entityHandle].position, myEngine.entities[entityHandle].scale, myEngine.entities[entityHandle].rotation);
+    if (myEngine.entities[entityHandle].stationary == stationary)
+    {
+        return;
+    }
     if (myEngine.entities[entityHandle].batchHandle)
     {
-        const MyHandle batchHandle = myEngine.entities[entityHandle].batchHandle;
-        glNamedBufferSubData(myEngine.batches[batchHandle].transformBuffer, myEngine.entities[entityHandle].entityIndex * sizeof(MyTransform), sizeof(MyTransform), &myEngine.entities[entityHandle].transform);
+        my_batch_remove(entityHandle);
+        myEngine.entities[entityHandle].stationary = stationary;
+        my_batch_add(entityHandle);
+        return;
     }
+    myEngine.entities[entityHandle].stationary = stationary;
 }
 
-void my_entity_set_scale(MyHandle entityHandle, MyVector scale)
+void my_entity_set_layer(MyHandle entityHandle, MyHandle layerHandle)
 {
-    myEngine.entities[entityHandle].scale = my_vector_scale(myEngine.entities[entityHandle].scale, scale);
-    myEngine.entities[entityHandle].transform = my_transform_compose(myEngine.entities[entityHandle].position, myEngine.entities[entityHandle].scale, myEngine.entities[entityHandle].rotation);
+    if (myEngine.entities[entityHandle].layerHandle == layerHandle)
+    {
+        return;
+    }
     if (myEngine.entities[entityHandle].batchHandle)
     {
-        const MyHandle batchHandle = myEngine.entities[entityHandle].batchHandle;
-        glNamedBufferSubData(myEngine.batches[batchHandle].transformBuffer, myEngine.entities[entityHandle].entityIndex * sizeof(MyTransform), sizeof(MyTransform), &myEngine.entities[entityHandle].transform);
+        my_batch_remove(entityHandle);
+        myEngine.entities[entityHandle].layerHandle = layerHandle;
+        my_batch_add(entityHandle);
+        return;
     }
+    myEngine.entities[entityHandle].layerHandle = layerHandle;
 }
 
-void my_entity_set_rotation(MyHandle entityHandle, MyVector rotation)
+void my_entity_set_sort_mode(MyHandle entityHandle, MySortMode sortMode)
 {
-    myEngine.entities[entityHandle].rotation = my_vector_add(myEngine.entities[entityHandle].rotation, rotation);
-    myEngine.entities[entityHandle].transform = my_transform_compose(myEngine.entities[entityHandle].position, myEngine.entities[entityHandle].scale, myEngine.entities[entityHandle].rotation);
+    if (myEngine.entities[entityHandle].sortMode == sortMode)
+    {
+        return;
+    }
     if (myEngine.entities[entityHandle].batchHandle)
     {
-        const MyHandle batchHandle = myEngine.entities[entityHandle].batchHandle;
-        glNamedBufferSubData(myEngine.batches[batchHandle].transformBuffer, myEngine.entities[entityHandle].entityIndex * sizeof(MyTransform), sizeof(MyTransform), &myEngine.entities[entityHandle].transform);
+        my_batch_remove(entityHandle);
+        myEngine.entities[entityHandle].sortMode = sortMode;
+        my_batch_add(entityHandle);
+        return;
     }
+    myEngine.entities[entityHandle].sortMode = sortMode;
+}
+
+void my_entity_set_sort_layer(MyHandle entityHandle, int sortLayer)
+{
+    myEngine.entities[entityHandle].sortLayer = sortLayer;
+    my_entity_mark(entityHandle);
+}
+
+void my_entity_set_sort_key(MyHandle entityHandle, float sortKey)
+{
+    myEngine.entities[entityHandle].sortKey = sortKey;
+    my_entity_mark(entityHandle);
+}
+
+void my_entity_set_position(MyHandle entityHandle, MyVector position)
+{
+    myEngine.entities[entityHandle].position = my_vector_add(myEngine.entities[entityHandle].position, position);
+    my_entity_mark(entityHandle);
+}
+
+void my_entity_set_scale(MyHandle entityHandle, MyVector scale)
+{
+    myEngine.entities[entityHandle].scale = my_vector_scale(myEngine.entities[entityHandle].scale, scale);
+    my_entity_mark(entityHandle);
+}
+
+void my_entity_set_rotation(MyHandle entityHandle, MyVector rotation)
+{
+    myEngine.entities[entityHandle].rotation = my_vector_add(myEngine.entities[entityHandle].rotation, rotation);
+    my_entity_mark(entityHandle);
 }
 
 MyVector my_entity_get_position(MyHandle entityHandle)
@@ -942,1150 +2114,4537 @@ MyVector my_entity_get_rotation(MyHandle entityHandle)
     return myEngine.entities[entityHandle].rotation;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// Texture Functions
-////////////////////////////////////////////////////////////////////////////////
-
-MyHandle my_texture_create(const char* imagePath, int frameCount)
+static void my_entity_mark(MyHandle entityHandle)
 {
-    MyHandle textureHandle = MY_INVALID_HANDLE;
-    for (int i = 1; i < myEngine.textureCapacity; i++)
+    if (myEngine.entities[entityHandle].dirty)
     {
-        if (!myEngine.textures[i].textureHandle)
-        {
-            textureHandle = i;
-            break;
-        }
+        return;
     }
-    if (!textureHandle)
+    if (myEngine.dirtyCount + 1 > myEngine.dirtyCapacity)
     {
-        MyTexture* textures = realloc(myEngine.textures, (myEngine.textureCapacity + MY_ALLOCATOR_TEXTURE) * sizeof(MyTexture));
-        if (!textures)
+        MyHandle* dirtyEntities = realloc(myEngine.dirtyEntities, (myEngine.dirtyCapacity + MY_ALLOCATOR_ENTITY) * sizeof(MyHandle));
+        if (!dirtyEntities)
         {
-            return MY_INVALID_HANDLE;
+            my_entity_update(entityHandle);
+            return;
         }
-        textureHandle = myEngine.textureCapacity;
-        myEngine.textures = textures;
-        myEngine.textureCapacity += MY_ALLOCATOR_TEXTURE;
+        myEngine.dirtyEntities = dirtyEntities;
+        myEngine.dirtyCapacity += MY_ALLOCATOR_ENTITY;
     }
-    const char* extension = my_file_extension(imagePath);
-    if (strcmp(extension, ".png") == 0)
+    myEngine.dirtyEntities[myEngine.dirtyCount] = entityHandle;
+    myEngine.dirtyCount++;
+    myEngine.entities[entityHandle].dirty = true;
+}
+
+static void my_entity_update(MyHandle entityHandle)
+{
+    if (myEngine.entities[entityHandle].type == MY_ENTITY_TYPE_MESH)
     {
-        myEngine.textures[textureHandle].pixels = stbi_load(imagePath, &myEngine.textures[textureHandle].width, &myEngine.textures[textureHandle].height, &myEngine.textures[textureHandle].channelCount, 0);
+        myEngine.entities[entityHandle].transform = my_transform_compose(myEngine.entities[entityHandle].position, myEngine.entities[entityHandle].scale, myEngine.entities[entityHandle].rotation);
     }
-    if (!myEngine.textures[textureHandle].pixels)
+    if (myEngine.entities[entityHandle].batchHandle)
     {
-        my_texture_destroy(textureHandle);
-        return MY_INVALID_HANDLE;
+        my_batch_store(entityHandle);
     }
-    if (myEngine.textures[textureHandle].channelCount == 4)
-    {
-        const int pixelsSize = myEngine.textures[textureHandle].width * myEngine.textures[textureHandle].height * 4;
-        for (int i = 3; i < pixelsSize; i += 4)
-        {
-            if (myEngine.textures[textureHandle].pixels[i] < 255)
-            {
-                myEngine.textures[textureHandle].transparent = true;
-                break;
-            }
-        }
-    }
-    myEngine.textures[textureHandle].frames = calloc(frameCount, sizeof(MyTextureFrame));
-    if (!myEngine.textures[textureHandle].frames)
-    {
-        my_texture_destroy(textureHandle);
-        return MY_INVALID_HANDLE;
-    }
-    for (int i = 0; i < frameCount; i++)
-    {
-        myEngine.textures[textureHandle].frames[i].width = myEngine.textures[textureHandle].width;
-        myEngine.textures[textureHandle].frames[i].height = myEngine.textures[textureHandle].height;
-    }
-    myEngine.textures[textureHandle].frameCount = frameCount;
-    glCreateTextures(GL_TEXTURE_2D, 1, &myEngine.textures[textureHandle].texture);
-    if (!myEngine.textures[textureHandle].texture)
-    {
-        my_texture_destroy(textureHandle);
-        return MY_INVALID_HANDLE;
-    }
-    glTextureParameteri(myEngine.textures[textureHandle].texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
-    glTextureParameteri(myEngine.textures[textureHandle].texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
-    glTextureParameteri(myEngine.textures[textureHandle].texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTextureParameteri(myEngine.textures[textureHandle].texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTextureStorage2D(myEngine.textures[textureHandle].texture, 1, GL_RGBA8, myEngine.textures[textureHandle].width, myEngine.textures[textureHandle].height);
-    glTextureSubImage2D(myEngine.textures[textureHandle].texture, 0, 0, 0, myEngine.textures[textureHandle].width, myEngine.textures[textureHandle].height, GL_RGBA, GL_UNSIGNED_BYTE, myEngine.textures[textureHandle].pixels);
-    myEngine.textures[textureHandle].textureHandle = textureHandle;
-    return textureHandle;
+    myEngine.entities[entityHandle].dirty = false;
 }
 
-void my_texture_destroy(MyHandle textureHandle)
+static MyHandle my_entity_allocate(void)
 {
-    for (int i = 1; i < myEngine.batchCapacity; i++)
+    MyHandle entityHandle = MY_INVALID_HANDLE;
+    for (int i = 1; i < myEngine.entityCapacity; i++)
     {
-        if (myEngine.batches[i].textureHandle == textureHandle)
+        if (!myEngine.entities[i].entityHandle)
         {
-            my_batch_destroy(i);
+            entityHandle = i;
+            break;
         }
     }
-    for (int i = 1; i < myEngine.entityCapacity; i++)
+    if (!entityHandle)
     {
-        if (myEngine.entities[i].textureHandle == textureHandle)
+        MyEntity* entities = realloc(myEngine.entities, (myEngine.entityCapacity + MY_ALLOCATOR_ENTITY) * sizeof(MyEntity));
+        if (!entities)
         {
-            myEngine.entities[i].textureHandle = MY_INVALID_HANDLE;
+            return MY_INVALID_HANDLE;
         }
+        memset(entities + myEngine.entityCapacity, 0, MY_ALLOCATOR_ENTITY * sizeof(MyEntity));
+        entityHandle = myEngine.entityCapacity;
+        myEngine.entities = entities;
+        myEngine.entityCapacity += MY_ALLOCATOR_ENTITY;
     }
-    if (myEngine.textures[textureHandle].pixels)
-    {
-        stbi_image_free(myEngine.textures[textureHandle].pixels);
-    }
-    if (myEngine.textures[textureHandle].frames)
-    {
-        free(myEngine.textures[textureHandle].frames);
-    }
-    if (myEngine.textures[textureHandle].texture)
-    {
-        glDeleteTextures(1, &myEngine.textures[textureHandle].texture);
-    }
-    myEngine.textures[textureHandle] = (MyTexture) { 0 };
-}
-
-void my_texture_set_frame(MyHandle textureHandle, int frameIndex, int x, int y, int width, int height)
-{
-    myEngine.textures[textureHandle].frames[frameIndex] = (MyTextureFrame) { x, y, width, height };
+    return entityHandle;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// Shader Functions
+// Geometry Functions
 ////////////////////////////////////////////////////////////////////////////////
 
-MyHandle my_shader_create(const char* vertexPath, const char* fragmentPath)
+MyHandle my_geometry_create(const float* vertices, int vertexCount, const void* indices, int indexCount, int indexSize)
 {
-    MyHandle shaderHandle = MY_INVALID_HANDLE;
-    for (int i = 1; i < myEngine.shaderCapacity; i++)
+    if (!vertices || !indices || vertexCount <= 0 || indexCount <= 0 || (indexSize != sizeof(GLushort) && indexSize != sizeof(GLuint)))
     {
-        if (!myEngine.shaders[i].shaderHandle)
-        {
-            shaderHandle = i;
-            break;
-        }
+        return MY_INVALID_HANDLE;
     }
-    if (!shaderHandle)
+    for (int i = 0; i < indexCount; i++)
     {
-        MyShader* shaders = realloc(myEngine.shaders, (myEngine.shaderCapacity + MY_ALLOCATOR_SHADER) * sizeof(MyShader));
-        if (!shaders)
+        const GLuint index = indexSize == sizeof(GLuint) ? ((const GLuint*) indices)[i] : ((const GLushort*) indices)[i];
+        if (index >= (GLuint) vertexCount)
         {
             return MY_INVALID_HANDLE;
         }
-        shaderHandle = myEngine.shaderCapacity;
-        myEngine.shaders = shaders;
-        myEngine.shaderCapacity += MY_ALLOCATOR_SHADER;
-    }
-    myEngine.shaders[shaderHandle].vertexStage = glCreateShader(GL_VERTEX_SHADER);
-    if (!myEngine.shaders[shaderHandle].vertexStage)
-    {
-        my_shader_destroy(shaderHandle);
-        return MY_INVALID_HANDLE;
     }
-    myEngine.shaders[shaderHandle].vertexText = my_file_read(vertexPath);
-    if (!myEngine.shaders[shaderHandle].vertexText)
-    {
-        my_shader_destroy(shaderHandle);
-        return MY_INVALID_HANDLE;
+    const int vertexSize = myEngine.pools[MY_ENTITY_TYPE_MESH].vertexSize;
+    GLuint64 hash = my_geometry_hash(MY_GEOMETRY_SEED, vertices, (size_t) vertexCount * vertexSize);
+    hash = my_geometry_hash(hash, indices, (size_t) indexCount * indexSize);
+    MyHandle geometryHandle = MY_INVALID_HANDLE;
+    for (int i = 1; i < myEngine.geometryCapacity; i++)
+    {
+        if (myEngine.geometries[i].geometryHandle &&
+            myEngine.geometries[i].hash == hash &&
+            myEngine.geometries[i].vertexCount == vertexCount &&
+            myEngine.geometries[i].indexCount == indexCount &&
+            myEngine.geometries[i].indexSize == indexSize &&
+            my_geometry_equal(i, vertices, indices))
+        {
+            myEngine.geometries[i].referenceCount++;
+            return i;
+        }
+        if (!geometryHandle && !myEngine.geometries[i].geometryHandle)
+        {
+            geometryHandle = i;
+        }
     }
-    const char* vertexTextConst = myEngine.shaders[shaderHandle].vertexText;
-    glShaderSource(myEngine.shaders[shaderHandle].vertexStage, 1, &vertexTextConst, NULL);
-    glCompileShader(myEngine.shaders[shaderHandle].vertexStage);
-    GLint vertexStatus = 0;
-    glGetShaderiv(myEngine.shaders[shaderHandle].vertexStage, GL_COMPILE_STATUS, &vertexStatus);
-    if (!vertexStatus)
+    if (!geometryHandle)
     {
-        my_shader_destroy(shaderHandle);
-        return MY_INVALID_HANDLE;
+        MyGeometry* geometries = realloc(myEngine.geometries, (myEngine.geometryCapacity + MY_ALLOCATOR_GEOMETRY) * sizeof(MyGeometry));
+        if (!geometries)
+        {
+            return MY_INVALID_HANDLE;
+        }
+        memset(geometries + myEngine.geometryCapacity, 0, MY_ALLOCATOR_GEOMETRY * sizeof(MyGeometry));
+        geometryHandle = myEngine.geometryCapacity;
+        myEngine.geometries = geometries;
+        myEngine.geometryCapacity += MY_ALLOCATOR_GEOMETRY;
     }
-    myEngine.shaders[shaderHandle].fragmentStage = glCreateShader(GL_FRAGMENT_SHADER);
-    if (!myEngine.shaders[shaderHandle].fragmentStage)
+    const int indexCapacity = (indexCount * indexSize + sizeof(GLuint) - 1) / sizeof(GLuint) * sizeof(GLuint);
+    unsigned char* data = malloc(vertexCount * vertexSize + indexCount * indexSize);
+    if (!data)
     {
-        my_shader_destroy(shaderHandle);
         return MY_INVALID_HANDLE;
     }
-    myEngine.shaders[shaderHandle].fragmentText = my_file_read(fragmentPath);
-    if (!myEngine.shaders[shaderHandle].fragmentText)
+    if (!my_geometry_reserve(vertexCount * vertexSize, indexCapacity))
     {
-        my_shader_destroy(shaderHandle);
+        free(data);
         return MY_INVALID_HANDLE;
     }
-    const char* fragmentTextConst = myEngine.shaders[shaderHandle].fragmentText;
-    glShaderSource(myEngine.shaders[shaderHandle].fragmentStage, 1, &fragmentTextConst, NULL);
-    glCompileShader(myEngine.shaders[shaderHandle].fragmentStage);
-    GLint fragmentStatus = 0;
-    glGetShaderiv(myEngine.shaders[shaderHandle].fragmentStage, GL_COMPILE_STATUS, &fragmentStatus);
-    if (!fragmentStatus)
+    memcpy(data, vertices, vertexCount * vertexSize);
+    memcpy(data + vertexCount * vertexSize, indices, indexCount * indexSize);
+    myEngine.geometries[geometryHandle].data = data;
+    myEngine.geometries[geometryHandle].geometryHandle = geometryHandle;
+    myEngine.geometries[geometryHandle].hash = hash;
+    myEngine.geometries[geometryHandle].vertexCount = vertexCount;
+    myEngine.geometries[geometryHandle].indexCount = indexCount;
+    myEngine.geometries[geometryHandle].indexSize = indexSize;
+    myEngine.geometries[geometryHandle].vertexBase = myEngine.pools[MY_ENTITY_TYPE_MESH].vertexOffset;
+    myEngine.geometries[geometryHandle].indexBase = myEngine.pools[MY_ENTITY_TYPE_MESH].indexOffset;
+    myEngine.geometries[geometryHandle].referenceCount = 1;
+    glNamedBufferSubData(myEngine.pools[MY_ENTITY_TYPE_MESH].vertexBuffer, myEngine.geometries[geometryHandle].vertexBase, vertexCount * vertexSize, vertices);
+    glNamedBufferSubData(myEngine.pools[MY_ENTITY_TYPE_MESH].indexBuffer, myEngine.geometries[geometryHandle].indexBase, indexCount * indexSize, indices);
+    myEngine.pools[MY_ENTITY_TYPE_MESH].vertexOffset += vertexCount * vertexSize;
+    myEngine.pools[MY_ENTITY_TYPE_MESH].indexOffset += indexCapacity;
+    my_geometry_bound(geometryHandle, vertices);
+    return geometryHandle;
+}
+
+MyHandle my_geometry_load(const char* meshPath)
+{
+    MyMapping mapping = { 0 };
+    if (!my_file_map(meshPath, &mapping))
     {
-        my_shader_destroy(shaderHandle);
         return MY_INVALID_HANDLE;
     }
-    myEngine.shaders[shaderHandle].program = glCreateProgram();
-    if (!myEngine.shaders[shaderHandle].program)
-    {
-        my_shader_destroy(shaderHandle);
+    const MyMeshHeader* header = mapping.data;
+    if (mapping.size < sizeof(MyMeshHeader) ||
+        header->magic != MY_MESH_MAGIC ||
+        header->version != MY_MESH_VERSION ||
+        (header->indexSize != sizeof(GLushort) && header->indexSize != sizeof(GLuint)) ||
+        header->vertexOffset % sizeof(GLfloat) ||
+        header->indexOffset % header->indexSize ||
+        header->vertexOffset + (size_t) header->vertexCount * myEngine.pools[MY_ENTITY_TYPE_MESH].vertexSize > mapping.size ||
+        header->indexOffset + (size_t) header->indexCount * header->indexSize > mapping.size)
+    {
+        my_file_unmap(&mapping);
         return MY_INVALID_HANDLE;
     }
-    glAttachShader(myEngine.shaders[shaderHandle].program, myEngine.shaders[shaderHandle].vertexStage);
-    glAttachShader(myEngine.shaders[shaderHandle].program, myEngine.shaders[shaderHandle].fragmentStage);
-    glLinkProgram(myEngine.shaders[shaderHandle].program);
-    GLint programStatus = 0;
-    glGetProgramiv(myEngine.shaders[shaderHandle].program, GL_LINK_STATUS, &programStatus);
-    if (!programStatus)
+    const float* vertices = (const float*) ((const unsigned char*) mapping.data + header->vertexOffset);
+    const void* indices = (const unsigned char*) mapping.data + header->indexOffset;
+    const MyHandle geometryHandle = my_geometry_create(vertices, header->vertexCount, indices, header->indexCount, header->indexSize);
+    my_file_unmap(&mapping);
+    return geometryHandle;
+}
+
+void my_geometry_destroy(MyHandle geometryHandle)
+{
+    if (myEngine.geometries[geometryHandle].referenceCount <= myEngine.geometries[geometryHandle].baseCount)
     {
-        my_shader_destroy(shaderHandle);
-        return MY_INVALID_HANDLE;
+        return;
     }
-    myEngine.shaders[shaderHandle].shaderHandle = shaderHandle;
-    return shaderHandle;
+    my_geometry_release(geometryHandle);
 }
 
-void my_shader_destroy(MyHandle shaderHandle)
+static bool my_geometry_reserve(int vertexCapacity, int indexCapacity)
 {
-    for (int i = 1; i < myEngine.batchCapacity; i++)
+    MyPool* pool = &myEngine.pools[MY_ENTITY_TYPE_MESH];
+    if (pool->vertexOffset + vertexCapacity <= pool->vertexCapacity && pool->indexOffset + indexCapacity <= pool->indexCapacity)
+    {
+        return true;
+    }
+    int vertexTotal = vertexCapacity;
+    int indexTotal = indexCapacity;
+    for (int i = 1; i < myEngine.geometryCapacity; i++)
     {
-        if (myEngine.batches[i].shaderHandle == shaderHandle)
+        if (myEngine.geometries[i].geometryHandle)
         {
-            my_batch_destroy(i);
+            vertexTotal += myEngine.geometries[i].vertexCount * pool->vertexSize;
+            indexTotal += (myEngine.geometries[i].indexCount * myEngine.geometries[i].indexSize + sizeof(GLuint) - 1) / sizeof(GLuint) * sizeof(GLuint);
         }
     }
-    for (int i = 1; i < myEngine.entityCapacity; i++)
+    int poolVertexCapacity = pool->vertexCapacity ? pool->vertexCapacity : MY_ALLOCATOR_POOL_VERTEX;
+    while (poolVertexCapacity < vertexTotal)
+    {
+        poolVertexCapacity *= 2;
+    }
+    int poolIndexCapacity = pool->indexCapacity ? pool->indexCapacity : MY_ALLOCATOR_POOL_INDEX;
+    while (poolIndexCapacity < indexTotal)
+    {
+        poolIndexCapacity *= 2;
+    }
+    GLuint vertexBuffer = 0;
+    GLuint indexBuffer = 0;
+    glCreateBuffers(1, &vertexBuffer);
+    glCreateBuffers(1, &indexBuffer);
+    if (!vertexBuffer || !indexBuffer)
+    {
+        glDeleteBuffers(1, &vertexBuffer);
+        glDeleteBuffers(1, &indexBuffer);
+        return false;
+    }
+    glNamedBufferStorage(vertexBuffer, poolVertexCapacity, NULL, GL_DYNAMIC_STORAGE_BIT);
+    glNamedBufferStorage(indexBuffer, poolIndexCapacity, NULL, GL_DYNAMIC_STORAGE_BIT);
+    int vertexOffset = 0;
+    int indexOffset = 0;
+    for (int i = 1; i < myEngine.geometryCapacity; i++)
     {
-        if (myEngine.entities[i].shaderHandle == shaderHandle)
+        if (myEngine.geometries[i].geometryHandle)
         {
-            myEngine.entities[i].shaderHandle = MY_INVALID_HANDLE;
+            const int vertexSize = myEngine.geometries[i].vertexCount * pool->vertexSize;
+            const int indexSize = (myEngine.geometries[i].indexCount * myEngine.geometries[i].indexSize + sizeof(GLuint) - 1) / sizeof(GLuint) * sizeof(GLuint);
+            glCopyNamedBufferSubData(pool->vertexBuffer, vertexBuffer, myEngine.geometries[i].vertexBase, vertexOffset, vertexSize);
+            glCopyNamedBufferSubData(pool->indexBuffer, indexBuffer, myEngine.geometries[i].indexBase, indexOffset, indexSize);
+            myEngine.geometries[i].vertexBase = vertexOffset;
+            myEngine.geometries[i].indexBase = indexOffset;
+            vertexOffset += vertexSize;
+            indexOffset += indexSize;
         }
     }
-    if (myEngine.shaders[shaderHandle].vertexStage)
+    if (pool->vertexBuffer)
     {
-        glDeleteShader(myEngine.shaders[shaderHandle].vertexStage);
+        my_state_forget_buffer(pool->vertexBuffer);
+        glDeleteBuffers(1, &pool->vertexBuffer);
     }
-    if (myEngine.shaders[shaderHandle].fragmentStage)
+    if (pool->indexBuffer)
     {
-        glDeleteShader(myEngine.shaders[shaderHandle].fragmentStage);
+        my_state_forget_buffer(pool->indexBuffer);
+        glDeleteBuffers(1, &pool->indexBuffer);
     }
-    if (myEngine.shaders[shaderHandle].program)
+    pool->vertexBuffer = vertexBuffer;
+    pool->indexBuffer = indexBuffer;
+    pool->vertexCapacity = poolVertexCapacity;
+    pool->vertexOffset = vertexOffset;
+    pool->indexCapacity = poolIndexCapacity;
+    pool->indexOffset = indexOffset;
+    return true;
+}
+
+static void my_geometry_release(MyHandle geometryHandle)
+{
+    myEngine.geometries[geometryHandle].referenceCount--;
+    if (myEngine.geometries[geometryHandle].referenceCount > 0)
     {
-        glDeleteProgram(myEngine.shaders[shaderHandle].program);
+        return;
     }
-    if (myEngine.shaders[shaderHandle].vertexText)
+    MyPool* pool = &myEngine.pools[MY_ENTITY_TYPE_MESH];
+    const int vertexSize = myEngine.geometries[geometryHandle].vertexCount * pool->vertexSize;
+    const int indexSize = (myEngine.geometries[geometryHandle].indexCount * myEngine.geometries[geometryHandle].indexSize + sizeof(GLuint) - 1) / sizeof(GLuint) * sizeof(GLuint);
+    if (myEngine.geometries[geometryHandle].vertexBase + vertexSize == pool->vertexOffset)
     {
-        free(myEngine.shaders[shaderHandle].vertexText);
+        pool->vertexOffset = myEngine.geometries[geometryHandle].vertexBase;
     }
-    if (myEngine.shaders[shaderHandle].fragmentText)
+    if (myEngine.geometries[geometryHandle].indexBase + indexSize == pool->indexOffset)
     {
-        free(myEngine.shaders[shaderHandle].fragmentText);
+        pool->indexOffset = myEngine.geometries[geometryHandle].indexBase;
     }
-    myEngine.shaders[shaderHandle] = (MyShader) { 0 };
+    free(myEngine.geometries[geometryHandle].data);
+    myEngine.geometries[geometryHandle] = (MyGeometry) { 0 };
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// Camera Functions
-////////////////////////////////////////////////////////////////////////////////
+static void my_geometry_bound(MyHandle geometryHandle, const float* vertices)
+{
+    const int vertexCount = myEngine.geometries[geometryHandle].vertexCount;
+    const int vertexStride = myEngine.pools[MY_ENTITY_TYPE_MESH].vertexSize / sizeof(GLfloat);
+    MyVector floor = my_vector_uniform(FLT_MAX);
+    MyVector ceiling = my_vector_uniform(-FLT_MAX);
+    for (int i = 0; i < vertexCount; i++)
+    {
+        const float* vertex = vertices + i * vertexStride;
+        floor = (MyVector) { fminf(floor.x, vertex[0]), fminf(floor.y, vertex[1]), fminf(floor.z, vertex[2]) };
+        ceiling = (MyVector) { fmaxf(ceiling.x, vertex[0]), fmaxf(ceiling.y, vertex[1]), fmaxf(ceiling.z, vertex[2]) };
+    }
+    const MyVector center = my_vector_scale(my_vector_add(floor, ceiling), my_vector_uniform(0.5f));
+    float radius = 0.0f;
+    for (int i = 0; i < vertexCount; i++)
+    {
+        const float* vertex = vertices + i * vertexStride;
+        const MyVector distance = my_vector_subtract((MyVector) { vertex[0], vertex[1], vertex[2] }, center);
+        radius = fmaxf(radius, my_vector_dot(distance, distance));
+    }
+    myEngine.geometries[geometryHandle].boundsCenter = center;
+    myEngine.geometries[geometryHandle].boundsRadius = sqrtf(radius);
+}
 
-MyHandle my_camera_create_orthographic(float left, float right, float bottom, float top, float far, float near)
+static bool my_geometry_equal(MyHandle geometryHandle, const float* vertices, const void* indices)
 {
-    MyHandle cameraHandle = MY_INVALID_HANDLE;
-    for (int i = 1; i < myEngine.cameraCapacity; i++)
+    const int vertexSize = myEngine.geometries[geometryHandle].vertexCount * myEngine.pools[MY_ENTITY_TYPE_MESH].vertexSize;
+    const int indexSize = myEngine.geometries[geometryHandle].indexCount * myEngine.geometries[geometryHandle].indexSize;
+    return !memcmp(myEngine.geometries[geometryHandle].data, vertices, vertexSize) &&
+        !memcmp(myEngine.geometries[geometryHandle].data + vertexSize, indices, indexSize);
+}
+
+static GLuint64 my_geometry_hash(GLuint64 hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = data;
+    for (size_t i = 0; i < size; i++)
     {
-        if (!myEngine.cameras[i].cameraHandle)
+        hash = (hash ^ bytes[i]) * MY_GEOMETRY_PRIME;
+    }
+    return hash;
+}
+
+static void my_geometry_vertex(float* vertices, int vertexIndex, MyVector position, MyVector normal, float u, float v)
+{
+    float* vertex = vertices + vertexIndex * 8;
+    vertex[0] = position.x;
+    vertex[1] = position.y;
+    vertex[2] = position.z;
+    vertex[3] = u;
+    vertex[4] = v;
+    vertex[5] = normal.x;
+    vertex[6] = normal.y;
+    vertex[7] = normal.z;
+}
+
+static MyHandle my_geometry_quad(void)
+{
+    float vertices[4 * 8];
+    my_geometry_vertex(vertices, 0, (MyVector) { -0.5f, -0.5f, 0.0f }, (MyVector) { 0.0f, 0.0f, 1.0f }, 0.0f, 0.0f);
+    my_geometry_vertex(vertices, 1, (MyVector) { 0.5f, -0.5f, 0.0f }, (MyVector) { 0.0f, 0.0f, 1.0f }, 1.0f, 0.0f);
+    my_geometry_vertex(vertices, 2, (MyVector) { 0.5f, 0.5f, 0.0f }, (MyVector) { 0.0f, 0.0f, 1.0f }, 1.0f, 1.0f);
+    my_geometry_vertex(vertices, 3, (MyVector) { -0.5f, 0.5f, 0.0f }, (MyVector) { 0.0f, 0.0f, 1.0f }, 0.0f, 1.0f);
+    return my_geometry_create(vertices, 4, myQuadIndices, sizeof(myQuadIndices) / sizeof(GLushort), sizeof(GLushort));
+}
+
+static MyHandle my_geometry_cube(void)
+{
+    const MyVector normals[6] = { { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f } };
+    const MyVector tangents[6] = { { 0.0f, 0.0f, -1.0f }, { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f } };
+    const MyVector bitangents[6] = { { 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } };
+    const float corners[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+    float vertices[6 * 4 * 8];
+    GLushort indices[6 * 6];
+    for (int i = 0; i < 6; i++)
+    {
+        for (int j = 0; j < 4; j++)
         {
-            cameraHandle = i;
-            break;
+            const MyVector tangent = my_vector_scale(tangents[i], my_vector_uniform(corners[j][0] - 0.5f));
+            const MyVector bitangent = my_vector_scale(bitangents[i], my_vector_uniform(corners[j][1] - 0.5f));
+            const MyVector position = my_vector_add(my_vector_scale(normals[i], my_vector_uniform(0.5f)), my_vector_add(tangent, bitangent));
+            my_geometry_vertex(vertices, i * 4 + j, position, normals[i], corners[j][0], corners[j][1]);
         }
-    }
-    if (!cameraHandle)
-    {
-        MyCamera* cameras = realloc(myEngine.cameras, (myEngine.cameraCapacity + MY_ALLOCATOR_CAMERA) * sizeof(MyCamera));
-        if (!cameras)
+        for (int j = 0; j < 6; j++)
         {
-            return MY_INVALID_HANDLE;
+            indices[i * 6 + j] = i * 4 + myQuadIndices[j];
         }
-        cameraHandle = myEngine.cameraCapacity;
-        myEngine.cameras = cameras;
-        myEngine.cameraCapacity += MY_ALLOCATOR_CAMERA;
     }
-    myEngine.cameras[cameraHandle].cameraHandle = cameraHandle;
-    myEngine.cameras[cameraHandle].projection = MY_PROJECTION_ORTHOGRAPHIC;
-    myEngine.cameras[cameraHandle].left = left;
-    myEngine.cameras[cameraHandle].right = right;
-    myEngine.cameras[cameraHandle].bottom = bottom;
-    myEngine.cameras[cameraHandle].top = top;
-    myEngine.cameras[cameraHandle].far = far;
-    myEngine.cameras[cameraHandle].near = near;
-    myEngine.cameras[cameraHandle].dirty = true;
-    my_vector_basis(&myEngine.cameras[cameraHandle].basisX, &myEngine.cameras[cameraHandle].basisY, &myEngine.cameras[cameraHandle].basisZ, MY_VECTOR_ZERO);
-    return cameraHandle;
+    return my_geometry_create(vertices, 6 * 4, indices, 6 * 6, sizeof(GLushort));
 }
 
-MyHandle my_camera_create_perspective(float aspectRatio, float fieldOfView, float far, float near)
+static MyHandle my_geometry_sphere(void)
 {
-    MyHandle cameraHandle = MY_INVALID_HANDLE;
-    for (int i = 1; i < myEngine.cameraCapacity; i++)
+    float vertices[(MY_CAPACITY_STACK + 1) * (MY_CAPACITY_SEGMENT + 1) * 8];
+    GLushort indices[MY_CAPACITY_STACK * MY_CAPACITY_SEGMENT * 6];
+    for (int i = 0; i <= MY_CAPACITY_STACK; i++)
     {
-        if (!myEngine.cameras[i].cameraHandle)
+        const float pitch = 180.0f * i / MY_CAPACITY_STACK * MY_FLOAT_RADIANS;
+        for (int j = 0; j <= MY_CAPACITY_SEGMENT; j++)
         {
-            cameraHandle = i;
-            break;
+            const float yaw = 360.0f * j / MY_CAPACITY_SEGMENT * MY_FLOAT_RADIANS;
+            const MyVector normal = { sinf(pitch) * cosf(yaw), cosf(pitch), sinf(pitch) * sinf(yaw) };
+            my_geometry_vertex(vertices, i * (MY_CAPACITY_SEGMENT + 1) + j, my_vector_scale(normal, my_vector_uniform(0.5f)), normal, (float) j / MY_CAPACITY_SEGMENT, 1.0f - (float) i / MY_CAPACITY_STACK);
         }
     }
-    if (!cameraHandle)
+    int indexCount = 0;
+    for (int i = 0; i < MY_CAPACITY_STACK; i++)
     {
-        MyCamera* cameras = realloc(myEngine.cameras, (myEngine.cameraCapacity + MY_ALLOCATOR_CAMERA) * sizeof(MyCamera));
-        if (!cameras)
+        for (int j = 0; j < MY_CAPACITY_SEGMENT; j++)
         {
-            return MY_INVALID_HANDLE;
+            const GLushort first = i * (MY_CAPACITY_SEGMENT + 1) + j;
+            const GLushort second = first + MY_CAPACITY_SEGMENT + 1;
+            indices[indexCount++] = first;
+            indices[indexCount++] = first + 1;
+            indices[indexCount++] = second;
+            indices[indexCount++] = first + 1;
+            indices[indexCount++] = second + 1;
+            indices[indexCount++] = second;
         }
-        cameraHandle = myEngine.cameraCapacity;
-        myEngine.cameras = cameras;
-        myEngine.cameraCapacity += MY_ALLOCATOR_CAMERA;
     }
-    myEngine.cameras[cameraHandle].cameraHandle = cameraHandle;
-    myEngine.cameras[cameraHandle].projection = MY_PROJECTION_ORTHOGRAPHIC;
-    myEngine.cameras[cameraHandle].far = far;
-    myEngine.cameras[cameraHandle].near = near;
-    myEngine.cameras[cameraHandle].aspectRatio = aspectRatio;
-    myEngine.cameras[cameraHandle].fieldOfView = fieldOfView;
-    myEngine.cameras[cameraHandle].dirty = true;
-    my_vector_basis(&myEngine.cameras[cameraHandle].basisX, &myEngine.cameras[cameraHandle].basisY, &myEngine.cameras[cameraHandle].basisZ, MY_VECTOR_ZERO);
-    return cameraHandle;
+    return my_geometry_create(vertices, (MY_CAPACITY_STACK + 1) * (MY_CAPACITY_SEGMENT + 1), indices, indexCount, sizeof(GLushort));
 }
 
-void my_camera_destroy(MyHandle cameraHandle)
+static MyHandle my_geometry_cylinder(void)
 {
-    myEngine.cameras[cameraHandle] = (MyCamera) { 0 };
+    float vertices[(MY_CAPACITY_SEGMENT + 1) * 4 * 8 + 2 * 8];
+    GLushort indices[MY_CAPACITY_SEGMENT * 12];
+    const int topCenter = (MY_CAPACITY_SEGMENT + 1) * 4;
+    const int bottomCenter = topCenter + 1;
+    my_geometry_vertex(vertices, topCenter, (MyVector) { 0.0f, 0.5f, 0.0f }, (MyVector) { 0.0f, 1.0f, 0.0f }, 0.5f, 0.5f);
+    my_geometry_vertex(vertices, bottomCenter, (MyVector) { 0.0f, -0.5f, 0.0f }, (MyVector) { 0.0f, -1.0f, 0.0f }, 0.5f, 0.5f);
+    for (int i = 0; i <= MY_CAPACITY_SEGMENT; i++)
+    {
+        const float yaw = 360.0f * i / MY_CAPACITY_SEGMENT * MY_FLOAT_RADIANS;
+        const MyVector normal = { cosf(yaw), 0.0f, sinf(yaw) };
+        const float u = (float) i / MY_CAPACITY_SEGMENT;
+        const float capU = 0.5f + normal.x * 0.5f;
+        const float capV = 0.5f + normal.z * 0.5f;
+        my_geometry_vertex(vertices, i * 4, (MyVector) { normal.x * 0.5f, -0.5f, normal.z * 0.5f }, normal, u, 0.0f);
+        my_geometry_vertex(vertices, i * 4 + 1, (MyVector) { normal.x * 0.5f, 0.5f, normal.z * 0.5f }, normal, u, 1.0f);
+        my_geometry_vertex(vertices, i * 4 + 2, (MyVector) { normal.x * 0.5f, 0.5f, normal.z * 0.5f }, (MyVector) { 0.0f, 1.0f, 0.0f }, capU, capV);
+        my_geometry_vertex(vertices, i * 4 + 3, (MyVector) { normal.x * 0.5f, -0.5f, normal.z * 0.5f }, (MyVector) { 0.0f, -1.0f, 0.0f }, capU, capV);
+    }
+    int indexCount = 0;
+    for (int i = 0; i < MY_CAPACITY_SEGMENT; i++)
+    {
+        const GLushort current = i * 4;
+        const GLushort next = current + 4;
+        indices[indexCount++] = current;
+        indices[indexCount++] = current + 1;
+        indices[indexCount++] = next;
+        indices[indexCount++] = next;
+        indices[indexCount++] = current + 1;
+        indices[indexCount++] = next + 1;
+        indices[indexCount++] = topCenter;
+        indices[indexCount++] = next + 2;
+        indices[indexCount++] = current + 2;
+        indices[indexCount++] = bottomCenter;
+        indices[indexCount++] = current + 3;
+        indices[indexCount++] = next + 3;
+    }
+    return my_geometry_create(vertices, (MY_CAPACITY_SEGMENT + 1) * 4 + 2, indices, indexCount, sizeof(GLushort));
 }
 
-void my_camera_activate(MyHandle cameraHandle)
-{
-    myEngine.cameraHandle = cameraHandle;
-    myEngine.cameras[cameraHandle].dirty = true;
-}
+////////////////////////////////////////////////////////////////////////////////
+// Texture Functions
+////////////////////////////////////////////////////////////////////////////////
 
-void my_camera_move(MyHandle cameraHandle, MyVector distance, bool absolute)
+MyHandle my_texture_create(const char* imagePath, int frameCount)
 {
-    if (absolute)
+    MyHandle textureHandle = MY_INVALID_HANDLE;
+    for (int i = 1; i < myEngine.textureCapacity; i++)
     {
-        myEngine.cameras[cameraHandle].position = my_vector_add(myEngine.cameras[cameraHandle].position, distance);
+        if (!myEngine.textures[i].textureHandle)
+        {
+            textureHandle = i;
+            break;
+        }
     }
-    else
+    if (!textureHandle)
     {
-        if (distance.x)
+        MyTexture* textures = realloc(myEngine.textures, (myEngine.textureCapacity + MY_ALLOCATOR_TEXTURE) * sizeof(MyTexture));
+        if (!textures)
         {
-            const MyVector localDistanceX = my_vector_scale(myEngine.cameras[cameraHandle].basisX, (MyVector) { distance.x, distance.x, distance.x });
-            myEngine.cameras[cameraHandle].position = my_vector_add(myEngine.cameras[cameraHandle].position, localDistanceX);
+            return MY_INVALID_HANDLE;
         }
-        if (distance.y)
+        memset(textures + myEngine.textureCapacity, 0, MY_ALLOCATOR_TEXTURE * sizeof(MyTexture));
+        textureHandle = myEngine.textureCapacity;
+        myEngine.textures = textures;
+        myEngine.textureCapacity += MY_ALLOCATOR_TEXTURE;
+    }
+    const char* extension = my_file_extension(imagePath);
+    if (strcmp(extension, ".png") == 0)
+    {
+        myEngine.textures[textureHandle].pixels = stbi_load(imagePath, &myEngine.textures[textureHandle].width, &myEngine.textures[textureHandle].height, &myEngine.textures[textureHandle].channelCount, 0);
+    }
+    if (!myEngine.textures[textureHandle].pixels)
+    {
+        my_texture_destroy(textureHandle);
+        return MY_INVALID_HANDLE;
+    }
+    if (myEngine.textures[textureHandle].channelCount == 4)
+    {
+        const int pixelsSize = myEngine.textures[textureHandle].width * myEngine.textures[textureHandle].height * 4;
+        for (int i = 3; i < pixelsSize; i += 4)
         {
-            const MyVector localDistanceY = my_vector_scale(myEngine.cameras[cameraHandle].basisY, (MyVector) { distance.y, distance.y, distance.y });
-            myEngine.cameras[cameraHandle].position = my_vector_add(myEngine.cameras[cameraHandle].position, localDistanceY);
+            if (myEngine.textures[textureHandle].pixels[i] < 255)
+            {
+                myEngine.textures[textureHandle].transparent = true;
+                break;
+            }
         }
-        if (distance.z)
+    }
+    myEngine.textures[textureHandle].frames = calloc(frameCount, sizeof(MyTextureFrame));
+    if (!myEngine.textures[textureHandle].frames)
+    {
+        my_texture_destroy(textureHandle);
+        return MY_INVALID_HANDLE;
+    }
+    for (int i = 0; i < frameCount; i++)
+    {
+        myEngine.textures[textureHandle].frames[i].width = myEngine.textures[textureHandle].width;
+        myEngine.textures[textureHandle].frames[i].height = myEngine.textures[textureHandle].height;
+    }
+    myEngine.textures[textureHandle].frameCount = frameCount;
+    if (myEngine.bindless && !my_texture_reside(textureHandle))
+    {
+        my_texture_destroy(textureHandle);
+        return MY_INVALID_HANDLE;
+    }
+    if (!myEngine.bindless && !my_bucket_add(textureHandle))
+    {
+        my_texture_destroy(textureHandle);
+        return MY_INVALID_HANDLE;
+    }
+    if (!my_texture_allocate(textureHandle))
+    {
+        my_texture_destroy(textureHandle);
+        return MY_INVALID_HANDLE;
+    }
+    myEngine.textures[textureHandle].textureHandle = textureHandle;
+    return textureHandle;
+}
+
+void my_texture_destroy(MyHandle textureHandle)
+{
+    while (myEngine.textures[textureHandle].entityFirst)
+    {
+        const MyHandle entityHandle = myEngine.textures[textureHandle].entityFirst;
+        if (myEngine.entities[entityHandle].batchHandle)
         {
-            const MyVector localDistanceZ = my_vector_scale(myEngine.cameras[cameraHandle].basisZ, (MyVector) { distance.z, distance.z, distance.z });
-            myEngine.cameras[cameraHandle].position = my_vector_add(myEngine.cameras[cameraHandle].position, localDistanceZ);
+            my_batch_remove(entityHandle);
         }
+        my_texture_unlink(entityHandle);
+        myEngine.entities[entityHandle].textureHandle = MY_INVALID_HANDLE;
     }
-    myEngine.cameras[cameraHandle].dirty = true;
+    my_tilemap_unlink(textureHandle);
+    my_voxel_unlink(textureHandle);
+    if (myEngine.textures[textureHandle].frameBase)
+    {
+        my_texture_release(textureHandle);
+    }
+    if (myEngine.textures[textureHandle].bucketHandle)
+    {
+        my_bucket_remove(textureHandle);
+    }
+    if (myEngine.textures[textureHandle].residentHandle)
+    {
+        myEngine.makeTextureHandleNonResident(myEngine.textures[textureHandle].residentHandle);
+    }
+    if (myEngine.textures[textureHandle].texture)
+    {
+        my_state_forget_texture(myEngine.textures[textureHandle].texture);
+        glDeleteTextures(1, &myEngine.textures[textureHandle].texture);
+    }
+    if (myEngine.textures[textureHandle].pixels)
+    {
+        stbi_image_free(myEngine.textures[textureHandle].pixels);
+    }
+    if (myEngine.textures[textureHandle].frames)
+    {
+        free(myEngine.textures[textureHandle].frames);
+    }
+    myEngine.textures[textureHandle] = (MyTexture) { 0 };
 }
 
-void my_camera_rotate(MyHandle cameraHandle, MyVector rotation)
+void my_texture_set_frame(MyHandle textureHandle, int frameIndex, int x, int y, int width, int height)
 {
-    rotation = my_vector_add(myEngine.cameras[cameraHandle].rotation, rotation);
-    rotation.x = my_float_clamp(rotation.x, -89.0f, 89.0f);
-    rotation.y = my_float_wrap(rotation.y, 0.0f, 360.0f);
-    rotation.z = my_float_wrap(rotation.z, 0.0f, 360.0f);
-    my_vector_basis(&myEngine.cameras[cameraHandle].basisX, &myEngine.cameras[cameraHandle].basisY, &myEngine.cameras[cameraHandle].basisZ, rotation);
-    myEngine.cameras[cameraHandle].rotation = rotation;
-    myEngine.cameras[cameraHandle].dirty = true;
+    myEngine.textures[textureHandle].frames[frameIndex] = (MyTextureFrame) { x, y, width, height };
+    const MyFrame frame = my_texture_frame(textureHandle, frameIndex);
+    glNamedBufferSubData(myEngine.frameBuffer, (myEngine.textures[textureHandle].frameBase + frameIndex) * sizeof(MyFrame), sizeof(MyFrame), &frame);
 }
 
-void my_camera_set_position(MyHandle cameraHandle, MyVector position)
+static bool my_texture_reside(MyHandle textureHandle)
 {
-    myEngine.cameras[cameraHandle].position = position;
-    myEngine.cameras[cameraHandle].dirty = true;
+    glCreateTextures(GL_TEXTURE_2D, 1, &myEngine.textures[textureHandle].texture);
+    if (!myEngine.textures[textureHandle].texture)
+    {
+        return false;
+    }
+    glTextureParameteri(myEngine.textures[textureHandle].texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(myEngine.textures[textureHandle].texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(myEngine.textures[textureHandle].texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTextureParameteri(myEngine.textures[textureHandle].texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTextureStorage2D(myEngine.textures[textureHandle].texture, 1, GL_RGBA8, myEngine.textures[textureHandle].width, myEngine.textures[textureHandle].height);
+    glTextureSubImage2D(myEngine.textures[textureHandle].texture, 0, 0, 0, myEngine.textures[textureHandle].width, myEngine.textures[textureHandle].height, GL_RGBA, GL_UNSIGNED_BYTE, myEngine.textures[textureHandle].pixels);
+    if (myEngine.textureCapacity > myEngine.residentCapacity)
+    {
+        const GLuint residentBuffer = my_batch_resize(myEngine.residentBuffer, myEngine.residentCapacity * sizeof(GLuint64), myEngine.textureCapacity * sizeof(GLuint64));
+        if (!residentBuffer)
+        {
+            return false;
+        }
+        myEngine.residentBuffer = residentBuffer;
+        myEngine.residentCapacity = myEngine.textureCapacity;
+        my_state_bind_storage_buffer(MY_BUFFER_TEXTURE, myEngine.residentBuffer);
+    }
+    const GLuint64 residentHandle = myEngine.getTextureHandle(myEngine.textures[textureHandle].texture);
+    if (!residentHandle)
+    {
+        return false;
+    }
+    myEngine.makeTextureHandleResident(residentHandle);
+    glNamedBufferSubData(myEngine.residentBuffer, textureHandle * sizeof(GLuint64), sizeof(GLuint64), &residentHandle);
+    if (textureHandle == MY_DEFAULT_TEXTURE)
+    {
+        glNamedBufferSubData(myEngine.residentBuffer, MY_INVALID_HANDLE * sizeof(GLuint64), sizeof(GLuint64), &residentHandle);
+    }
+    myEngine.textures[textureHandle].residentHandle = residentHandle;
+    myEngine.textures[textureHandle].layerIndex = textureHandle;
+    return true;
 }
 
-void my_camera_set_rotation(MyHandle cameraHandle, MyVector rotation)
+static bool my_texture_allocate(MyHandle textureHandle)
 {
-    rotation.x = my_float_clamp(rotation.x, -89.0f, 89.0f);
-    rotation.y = my_float_wrap(rotation.y, 0.0f, 360.0f);
-    rotation.z = my_float_wrap(rotation.z, 0.0f, 360.0f);
-    my_vector_basis(&myEngine.cameras[cameraHandle].basisX, &myEngine.cameras[cameraHandle].basisY, &myEngine.cameras[cameraHandle].basisZ, rotation);
-    myEngine.cameras[cameraHandle].rotation = rotation;
-    myEngine.cameras[cameraHandle].dirty = true;
+    const int frameCount = myEngine.textures[textureHandle].frameCount;
+    if (myEngine.frameBuffer && myEngine.frameOffset + frameCount <= myEngine.frameCapacity)
+    {
+        myEngine.textures[textureHandle].frameBase = myEngine.frameOffset;
+        myEngine.frameOffset += frameCount;
+        my_texture_upload(textureHandle);
+        return true;
+    }
+    int frameTotal = 1 + frameCount;
+    for (int i = 1; i < myEngine.textureCapacity; i++)
+    {
+        if (myEngine.textures[i].textureHandle && i != textureHandle)
+        {
+            frameTotal += myEngine.textures[i].frameCount;
+        }
+    }
+    int frameCapacity = myEngine.frameCapacity ? myEngine.frameCapacity : MY_ALLOCATOR_FRAME;
+    while (frameCapacity < frameTotal)
+    {
+        frameCapacity *= 2;
+    }
+    GLuint frameBuffer = 0;
+    glCreateBuffers(1, &frameBuffer);
+    if (!frameBuffer)
+    {
+        return false;
+    }
+    glNamedBufferStorage(frameBuffer, frameCapacity * sizeof(MyFrame), NULL, GL_DYNAMIC_STORAGE_BIT);
+    const MyFrame frame = { 0, 0, USHRT_MAX, USHRT_MAX, 0, 0 };
+    glNamedBufferSubData(frameBuffer, 0, sizeof(MyFrame), &frame);
+    if (myEngine.frameBuffer)
+    {
+        my_state_forget_buffer(myEngine.frameBuffer);
+        glDeleteBuffers(1, &myEngine.frameBuffer);
+    }
+    myEngine.frameBuffer = frameBuffer;
+    myEngine.frameCapacity = frameCapacity;
+    myEngine.frameOffset = 1;
+    my_state_bind_storage_buffer(MY_BUFFER_FRAME, myEngine.frameBuffer);
+    for (int i = 1; i < myEngine.textureCapacity; i++)
+    {
+        if (myEngine.textures[i].textureHandle && i != textureHandle)
+        {
+            myEngine.textures[i].frameBase = myEngine.frameOffset;
+            myEngine.frameOffset += myEngine.textures[i].frameCount;
+            my_texture_upload(i);
+            my_tilemap_refresh(i);
+            for (MyHandle entityHandle = myEngine.textures[i].entityFirst; entityHandle; entityHandle = myEngine.entities[entityHandle].textureNext)
+            {
+                if (myEngine.entities[entityHandle].batchHandle)
+                {
+                    my_batch_store(entityHandle);
+                }
+            }
+        }
+    }
+    myEngine.textures[textureHandle].frameBase = myEngine.frameOffset;
+    myEngine.frameOffset += frameCount;
+    my_texture_upload(textureHandle);
+    return true;
+}
+
+static void my_texture_release(MyHandle textureHandle)
+{
+    if (myEngine.textures[textureHandle].frameBase + myEngine.textures[textureHandle].frameCount == myEngine.frameOffset)
+    {
+        myEngine.frameOffset = myEngine.textures[textureHandle].frameBase;
+    }
+    myEngine.textures[textureHandle].frameBase = 0;
+}
+
+static void my_texture_upload(MyHandle textureHandle)
+{
+    for (int i = 0; i < myEngine.textures[textureHandle].frameCount; i++)
+    {
+        const MyFrame frame = my_texture_frame(textureHandle, i);
+        glNamedBufferSubData(myEngine.frameBuffer, (myEngine.textures[textureHandle].frameBase + i) * sizeof(MyFrame), sizeof(MyFrame), &frame);
+    }
+}
+
+static MyFrame my_texture_frame(MyHandle textureHandle, int frameIndex)
+{
+    const MyHandle bucketHandle = myEngine.textures[textureHandle].bucketHandle;
+    const MyTextureFrame frame = myEngine.textures[textureHandle].frames[frameIndex];
+    const float layerWidth = bucketHandle ? myEngine.buckets[bucketHandle].width : myEngine.textures[textureHandle].width;
+    const float layerHeight = bucketHandle ? myEngine.buckets[bucketHandle].height : myEngine.textures[textureHandle].height;
+    return (MyFrame)
+    {
+        (GLushort) (frame.x / layerWidth * USHRT_MAX + 0.5f),
+        (GLushort) (frame.y / layerHeight * USHRT_MAX + 0.5f),
+        (GLushort) (frame.width / layerWidth * USHRT_MAX + 0.5f),
+        (GLushort) (frame.height / layerHeight * USHRT_MAX + 0.5f),
+        myEngine.textures[textureHandle].layerIndex,
+        0
+    };
+}
+
+static GLuint my_texture_slot(MyHandle textureHandle, int frameIndex)
+{
+    if (!myEngine.textures[textureHandle].textureHandle)
+    {
+        return 0;
+    }
+    if (frameIndex < 0 || frameIndex >= myEngine.textures[textureHandle].frameCount)
+    {
+        return myEngine.textures[textureHandle].frameBase;
+    }
+    return myEngine.textures[textureHandle].frameBase + frameIndex;
+}
+
+static void my_texture_link(MyHandle entityHandle)
+{
+    const MyHandle textureHandle = myEngine.entities[entityHandle].textureHandle;
+    if (!textureHandle)
+    {
+        return;
+    }
+    const MyHandle nextHandle = myEngine.textures[textureHandle].entityFirst;
+    myEngine.entities[entityHandle].textureNext = nextHandle;
+    myEngine.entities[entityHandle].texturePrevious = MY_INVALID_HANDLE;
+    if (nextHandle)
+    {
+        myEngine.entities[nextHandle].texturePrevious = entityHandle;
+    }
+    myEngine.textures[textureHandle].entityFirst = entityHandle;
+}
+
+static void my_texture_unlink(MyHandle entityHandle)
+{
+    const MyHandle textureHandle = myEngine.entities[entityHandle].textureHandle;
+    if (!textureHandle)
+    {
+        return;
+    }
+    const MyHandle nextHandle = myEngine.entities[entityHandle].textureNext;
+    const MyHandle previousHandle = myEngine.entities[entityHandle].texturePrevious;
+    if (previousHandle)
+    {
+        myEngine.entities[previousHandle].textureNext = nextHandle;
+    }
+    else
+    {
+        myEngine.textures[textureHandle].entityFirst = nextHandle;
+    }
+    if (nextHandle)
+    {
+        myEngine.entities[nextHandle].texturePrevious = previousHandle;
+    }
+    myEngine.entities[entityHandle].textureNext = MY_INVALID_HANDLE;
+    myEngine.entities[entityHandle].texturePrevious = MY_INVALID_HANDLE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Shader Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MyHandle my_shader_create(const char* vertexPath, const char* fragmentPath)
+{
+    MyHandle shaderHandle = MY_INVALID_HANDLE;
+    for (int i = 1; i < myEngine.shaderCapacity; i++)
+    {
+        if (!myEngine.shaders[i].shaderHandle)
+        {
+            shaderHandle = i;
+            break;
+        }
+    }
+    if (!shaderHandle)
+    {
+        MyShader* shaders = realloc(myEngine.shaders, (myEngine.shaderCapacity + MY_ALLOCATOR_SHADER) * sizeof(MyShader));
+        if (!shaders)
+        {
+            return MY_INVALID_HANDLE;
+        }
+        memset(shaders + myEngine.shaderCapacity, 0, MY_ALLOCATOR_SHADER * sizeof(MyShader));
+        shaderHandle = myEngine.shaderCapacity;
+        myEngine.shaders = shaders;
+        myEngine.shaderCapacity += MY_ALLOCATOR_SHADER;
+    }
+    myEngine.shaders[shaderHandle].vertexStage = glCreateShader(GL_VERTEX_SHADER);
+    if (!myEngine.shaders[shaderHandle].vertexStage)
+    {
+        my_shader_destroy(shaderHandle);
+        return MY_INVALID_HANDLE;
+    }
+    myEngine.shaders[shaderHandle].vertexText = my_file_read(vertexPath);
+    if (!myEngine.shaders[shaderHandle].vertexText)
+    {
+        my_shader_destroy(shaderHandle);
+        return MY_INVALID_HANDLE;
+    }
+    if (!my_shader_compile(myEngine.shaders[shaderHandle].vertexStage, myEngine.shaders[shaderHandle].vertexText))
+    {
+        my_shader_destroy(shaderHandle);
+        return MY_INVALID_HANDLE;
+    }
+    myEngine.shaders[shaderHandle].fragmentStage = glCreateShader(GL_FRAGMENT_SHADER);
+    if (!myEngine.shaders[shaderHandle].fragmentStage)
+    {
+        my_shader_destroy(shaderHandle);
+        return MY_INVALID_HANDLE;
+    }
+    myEngine.shaders[shaderHandle].fragmentText = my_file_read(fragmentPath);
+    if (!myEngine.shaders[shaderHandle].fragmentText)
+    {
+        my_shader_destroy(shaderHandle);
+        return MY_INVALID_HANDLE;
+    }
+    if (!my_shader_compile(myEngine.shaders[shaderHandle].fragmentStage, myEngine.shaders[shaderHandle].fragmentText))
+    {
+        my_shader_destroy(shaderHandle);
+        return MY_INVALID_HANDLE;
+    }
+    myEngine.shaders[shaderHandle].program = glCreateProgram();
+    if (!myEngine.shaders[shaderHandle].program)
+    {
+        my_shader_destroy(shaderHandle);
+        return MY_INVALID_HANDLE;
+    }
+    glAttachShader(myEngine.shaders[shaderHandle].program, myEngine.shaders[shaderHandle].vertexStage);
+    glAttachShader(myEngine.shaders[shaderHandle].program, myEngine.shaders[shaderHandle].fragmentStage);
+    glLinkProgram(myEngine.shaders[shaderHandle].program);
+    GLint programStatus = 0;
+    glGetProgramiv(myEngine.shaders[shaderHandle].program, GL_LINK_STATUS, &programStatus);
+    if (!programStatus)
+    {
+        my_shader_destroy(shaderHandle);
+        return MY_INVALID_HANDLE;
+    }
+    glProgramUniform1i(myEngine.shaders[shaderHandle].program, MY_UNIFORM_ENTITY_TEXTURE, MY_SAMPLER_ENTITY);
+    myEngine.shaders[shaderHandle].shaderHandle = shaderHandle;
+    return shaderHandle;
+}
+
+void my_shader_destroy(MyHandle shaderHandle)
+{
+    while (myEngine.shaders[shaderHandle].entityFirst)
+    {
+        const MyHandle entityHandle = myEngine.shaders[shaderHandle].entityFirst;
+        if (myEngine.entities[entityHandle].batchHandle)
+        {
+            my_batch_remove(entityHandle);
+        }
+        my_shader_unlink(entityHandle);
+        myEngine.entities[entityHandle].shaderHandle = MY_INVALID_HANDLE;
+    }
+    if (myEngine.shaders[shaderHandle].vertexStage)
+    {
+        glDeleteShader(myEngine.shaders[shaderHandle].vertexStage);
+    }
+    if (myEngine.shaders[shaderHandle].fragmentStage)
+    {
+        glDeleteShader(myEngine.shaders[shaderHandle].fragmentStage);
+    }
+    if (myEngine.shaders[shaderHandle].program)
+    {
+        my_state_forget_program(myEngine.shaders[shaderHandle].program);
+        glDeleteProgram(myEngine.shaders[shaderHandle].program);
+    }
+    if (myEngine.shaders[shaderHandle].vertexText)
+    {
+        free(myEngine.shaders[shaderHandle].vertexText);
+    }
+    if (myEngine.shaders[shaderHandle].fragmentText)
+    {
+        free(myEngine.shaders[shaderHandle].fragmentText);
+    }
+    myEngine.shaders[shaderHandle] = (MyShader) { 0 };
+}
+
+static bool my_shader_compile(GLuint stage, const char* text)
+{
+    const char* version = strstr(text, "#version");
+    const char* body = version ? strchr(version, '\n') : NULL;
+    if (body)
+    {
+        const char* texts[] = { text, myEngine.bindless ? "#define MY_BINDLESS\n" : "", body + 1 };
+        const GLint lengths[] = { (GLint) (body + 1 - text), -1, -1 };
+        glShaderSource(stage, 3, texts, lengths);
+    }
+    else
+    {
+        glShaderSource(stage, 1, &text, NULL);
+    }
+    glCompileShader(stage);
+    GLint status = 0;
+    glGetShaderiv(stage, GL_COMPILE_STATUS, &status);
+    return status;
+}
+
+static GLuint my_shader_compute(const char* computePath)
+{
+    const GLuint computeStage = glCreateShader(GL_COMPUTE_SHADER);
+    if (!computeStage)
+    {
+        return 0;
+    }
+    char* computeText = my_file_read(computePath);
+    if (!computeText)
+    {
+        glDeleteShader(computeStage);
+        return 0;
+    }
+    const bool computeStatus = my_shader_compile(computeStage, computeText);
+    free(computeText);
+    if (!computeStatus)
+    {
+        glDeleteShader(computeStage);
+        return 0;
+    }
+    GLuint program = glCreateProgram();
+    if (program)
+    {
+        glAttachShader(program, computeStage);
+        glLinkProgram(program);
+        GLint programStatus = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &programStatus);
+        if (!programStatus)
+        {
+            glDeleteProgram(program);
+            program = 0;
+        }
+    }
+    glDeleteShader(computeStage);
+    return program;
+}
+
+static void my_shader_link(MyHandle entityHandle)
+{
+    const MyHandle shaderHandle = myEngine.entities[entityHandle].shaderHandle;
+    if (!shaderHandle)
+    {
+        return;
+    }
+    const MyHandle nextHandle = myEngine.shaders[shaderHandle].entityFirst;
+    myEngine.entities[entityHandle].shaderNext = nextHandle;
+    myEngine.entities[entityHandle].shaderPrevious = MY_INVALID_HANDLE;
+    if (nextHandle)
+    {
+        myEngine.entities[nextHandle].shaderPrevious = entityHandle;
+    }
+    myEngine.shaders[shaderHandle].entityFirst = entityHandle;
+}
+
+static void my_shader_unlink(MyHandle entityHandle)
+{
+    const MyHandle shaderHandle = myEngine.entities[entityHandle].shaderHandle;
+    if (!shaderHandle)
+    {
+        return;
+    }
+    const MyHandle nextHandle = myEngine.entities[entityHandle].shaderNext;
+    const MyHandle previousHandle = myEngine.entities[entityHandle].shaderPrevious;
+    if (previousHandle)
+    {
+        myEngine.entities[previousHandle].shaderNext = nextHandle;
+    }
+    else
+    {
+        myEngine.shaders[shaderHandle].entityFirst = nextHandle;
+    }
+    if (nextHandle)
+    {
+        myEngine.entities[nextHandle].shaderPrevious = previousHandle;
+    }
+    myEngine.entities[entityHandle].shaderNext = MY_INVALID_HANDLE;
+    myEngine.entities[entityHandle].shaderPrevious = MY_INVALID_HANDLE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Camera Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MyHandle my_camera_create_orthographic(float left, float right, float bottom, float top, float far, float near)
+{
+    MyHandle cameraHandle = MY_INVALID_HANDLE;
+    for (int i = 1; i < myEngine.cameraCapacity; i++)
+    {
+        if (!myEngine.cameras[i].cameraHandle)
+        {
+            cameraHandle = i;
+            break;
+        }
+    }
+    if (!cameraHandle)
+    {
+        MyCamera* cameras = realloc(myEngine.cameras, (myEngine.cameraCapacity + MY_ALLOCATOR_CAMERA) * sizeof(MyCamera));
+        if (!cameras)
+        {
+            return MY_INVALID_HANDLE;
+        }
+        memset(cameras + myEngine.cameraCapacity, 0, MY_ALLOCATOR_CAMERA * sizeof(MyCamera));
+        cameraHandle = myEngine.cameraCapacity;
+        myEngine.cameras = cameras;
+        myEngine.cameraCapacity += MY_ALLOCATOR_CAMERA;
+    }
+    myEngine.cameras[cameraHandle].cameraHandle = cameraHandle;
+    myEngine.cameras[cameraHandle].projection = MY_PROJECTION_ORTHOGRAPHIC;
+    myEngine.cameras[cameraHandle].left = left;
+    myEngine.cameras[cameraHandle].right = right;
+    myEngine.cameras[cameraHandle].bottom = bottom;
+    myEngine.cameras[cameraHandle].top = top;
+    myEngine.cameras[cameraHandle].far = far;
+    myEngine.cameras[cameraHandle].near = near;
+    myEngine.cameras[cameraHandle].dirty = true;
+    my_vector_basis(&myEngine.cameras[cameraHandle].basisX, &myEngine.cameras[cameraHandle].basisY, &myEngine.cameras[cameraHandle].basisZ, MY_VECTOR_ZERO);
+    return cameraHandle;
+}
+
+MyHandle my_camera_create_perspective(float aspectRatio, float fieldOfView, float far, float near)
+{
+    MyHandle cameraHandle = MY_INVALID_HANDLE;
+    for (int i = 1; i < myEngine.cameraCapacity; i++)
+    {
+        if (!myEngine.cameras[i].cameraHandle)
+        {
+            cameraHandle = i;
+            break;
+        }
+    }
+    if (!cameraHandle)
+    {
+        MyCamera* cameras = realloc(myEngine.cameras, (myEngine.cameraCapacity + MY_ALLOCATOR_CAMERA) * sizeof(MyCamera));
+        if (!cameras)
+        {
+            return MY_INVALID_HANDLE;
+        }
+        memset(cameras + myEngine.cameraCapacity, 0, MY_ALLOCATOR_CAMERA * sizeof(MyCamera));
+        cameraHandle = myEngine.cameraCapacity;
+        myEngine.cameras = cameras;
+        myEngine.cameraCapacity += MY_ALLOCATOR_CAMERA;
+    }
+    myEngine.cameras[cameraHandle].cameraHandle = cameraHandle;
+    myEngine.cameras[cameraHandle].projection = MY_PROJECTION_PERSPECTIVE;
+    myEngine.cameras[cameraHandle].far = far;
+    myEngine.cameras[cameraHandle].near = near;
+    myEngine.cameras[cameraHandle].aspectRatio = aspectRatio;
+    myEngine.cameras[cameraHandle].fieldOfView = fieldOfView;
+    myEngine.cameras[cameraHandle].dirty = true;
+    my_vector_basis(&myEngine.cameras[cameraHandle].basisX, &myEngine.cameras[cameraHandle].basisY, &myEngine.cameras[cameraHandle].basisZ, MY_VECTOR_ZERO);
+    return cameraHandle;
+}
+
+void my_camera_destroy(MyHandle cameraHandle)
+{
+    myEngine.cameras[cameraHandle] = (MyCamera) { 0 };
+}
+
+void my_camera_activate(MyHandle cameraHandle)
+{
+    myEngine.cameraHandle = cameraHandle;
+    myEngine.cameras[cameraHandle].dirty = true;
+}
+
+void my_camera_move(MyHandle cameraHandle, MyVector distance, bool absolute)
+{
+    if (absolute)
+    {
+        myEngine.cameras[cameraHandle].position = my_vector_add(myEngine.cameras[cameraHandle].position, distance);
+    }
+    else
+    {
+        if (distance.x)
+        {
+            const MyVector localDistanceX = my_vector_scale(myEngine.cameras[cameraHandle].basisX, (MyVector) { distance.x, distance.x, distance.x });
+            myEngine.cameras[cameraHandle].position = my_vector_add(myEngine.cameras[cameraHandle].position, localDistanceX);
+        }
+        if (distance.y)
+        {
+            const MyVector localDistanceY = my_vector_scale(myEngine.cameras[cameraHandle].basisY, (MyVector) { distance.y, distance.y, distance.y });
+            myEngine.cameras[cameraHandle].position = my_vector_add(myEngine.cameras[cameraHandle].position, localDistanceY);
+        }
+        if (distance.z)
+        {
+            const MyVector localDistanceZ = my_vector_scale(myEngine.cameras[cameraHandle].basisZ, (MyVector) { distance.z, distance.z, distance.z });
+            myEngine.cameras[cameraHandle].position = my_vector_add(myEngine.cameras[cameraHandle].position, localDistanceZ);
+        }
+    }
+    myEngine.cameras[cameraHandle].dirty = true;
+}
+
+void my_camera_rotate(MyHandle cameraHandle, MyVector rotation)
+{
+    rotation = my_vector_add(myEngine.cameras[cameraHandle].rotation, rotation);
+    rotation.x = my_float_clamp(rotation.x, -89.0f, 89.0f);
+    rotation.y = my_float_wrap(rotation.y, 0.0f, 360.0f);
+    rotation.z = my_float_wrap(rotation.z, 0.0f, 360.0f);
+    my_vector_basis(&myEngine.cameras[cameraHandle].basisX, &myEngine.cameras[cameraHandle].basisY, &myEngine.cameras[cameraHandle].basisZ, rotation);
+    myEngine.cameras[cameraHandle].rotation = rotation;
+    myEngine.cameras[cameraHandle].dirty = true;
+}
+
+void my_camera_set_position(MyHandle cameraHandle, MyVector position)
+{
+    myEngine.cameras[cameraHandle].position = position;
+    myEngine.cameras[cameraHandle].dirty = true;
+}
+
+void my_camera_set_rotation(MyHandle cameraHandle, MyVector rotation)
+{
+    rotation.x = my_float_clamp(rotation.x, -89.0f, 89.0f);
+    rotation.y = my_float_wrap(rotation.y, 0.0f, 360.0f);
+    rotation.z = my_float_wrap(rotation.z, 0.0f, 360.0f);
+    my_vector_basis(&myEngine.cameras[cameraHandle].basisX, &myEngine.cameras[cameraHandle].basisY, &myEngine.cameras[cameraHandle].basisZ, rotation);
+    myEngine.cameras[cameraHandle].rotation = rotation;
+    myEngine.cameras[cameraHandle].dirty = true;
+}
+
+MyVector my_camera_get_position(MyHandle cameraHandle)
+{
+    return myEngine.cameras[cameraHandle].position;
+}
+
+MyVector my_camera_get_rotation(MyHandle cameraHandle)
+{
+    return myEngine.cameras[cameraHandle].rotation;
+}
+
+static void my_camera_update(MyHandle cameraHandle)
+{
+    const MyVector translation =
+    {
+        -my_vector_dot(myEngine.cameras[cameraHandle].position, myEngine.cameras[cameraHandle].basisX),
+        -my_vector_dot(myEngine.cameras[cameraHandle].position, myEngine.cameras[cameraHandle].basisY),
+        -my_vector_dot(myEngine.cameras[cameraHandle].position, myEngine.cameras[cameraHandle].basisZ)
+    };
+    myEngine.cameras[cameraHandle].viewTransform = (MyTransform)
+    {
+        myEngine.cameras[cameraHandle].basisX.x, myEngine.cameras[cameraHandle].basisY.x, myEngine.cameras[cameraHandle].basisZ.x, 0.0f,
+        myEngine.cameras[cameraHandle].basisX.y, myEngine.cameras[cameraHandle].basisY.y, myEngine.cameras[cameraHandle].basisZ.y, 0.0f,
+        myEngine.cameras[cameraHandle].basisX.z, myEngine.cameras[cameraHandle].basisY.z, myEngine.cameras[cameraHandle].basisZ.z, 0.0f,
+        translation.x, translation.y, translation.z, 1.0f
+    };
+    if (myEngine.cameras[cameraHandle].projection == MY_PROJECTION_ORTHOGRAPHIC)
+    {
+        const float scaleX = 2.0f / (myEngine.cameras[cameraHandle].right - myEngine.cameras[cameraHandle].left);
+        const float scaleY = 2.0f / (myEngine.cameras[cameraHandle].top - myEngine.cameras[cameraHandle].bottom);
+        const float scaleZ = 2.0f / (myEngine.cameras[cameraHandle].near - myEngine.cameras[cameraHandle].far);
+        myEngine.cameras[cameraHandle].projectionTransform = (MyTransform)
+        {
+            scaleX, 0.0f, 0.0f, 0.0f,
+            0.0f, scaleY, 0.0f, 0.0f,
+            0.0f, 0.0f, scaleZ, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f
+        };
+    }
+    else if (myEngine.cameras[cameraHandle].projection == MY_PROJECTION_PERSPECTIVE)
+    {
+        const float fieldOfViewRadians = myEngine.cameras[cameraHandle].fieldOfView * MY_FLOAT_RADIANS;
+        const float scaleX = 1.0f / (myEngine.cameras[cameraHandle].aspectRatio * tanf(fieldOfViewRadians * 0.5f));
+        const float scaleY = 1.0f / tanf(fieldOfViewRadians * 0.5f);
+        const float scaleZ = -myEngine.cameras[cameraHandle].far / (myEngine.cameras[cameraHandle].far - myEngine.cameras[cameraHandle].near);
+        const float translateZ = myEngine.cameras[cameraHandle].far * myEngine.cameras[cameraHandle].near / (myEngine.cameras[cameraHandle].near - myEngine.cameras[cameraHandle].far);
+        myEngine.cameras[cameraHandle].projectionTransform = (MyTransform)
+        {
+            scaleX, 0.0f, 0.0f, 0.0f,
+            0.0f, scaleY, 0.0f, 0.0f,
+            0.0f, 0.0f, scaleZ, 1.0f,
+            0.0f, 0.0f, translateZ, 0.0f
+        };
+    }
+    const MyTransform clipTransform = my_transform_multiply(myEngine.cameras[cameraHandle].projectionTransform, myEngine.cameras[cameraHandle].viewTransform);
+    const MyPlane clipRows[] =
+    {
+        { { clipTransform.m1, clipTransform.m2, clipTransform.m3 }, clipTransform.m4 },
+        { { clipTransform.m5, clipTransform.m6, clipTransform.m7 }, clipTransform.m8 },
+        { { clipTransform.m9, clipTransform.m10, clipTransform.m11 }, clipTransform.m12 }
+    };
+    const MyPlane clipW = { { clipTransform.m13, clipTransform.m14, clipTransform.m15 }, clipTransform.m16 };
+    myEngine.cameras[cameraHandle].planeCount = myEngine.cameras[cameraHandle].projection == MY_PROJECTION_ORTHOGRAPHIC ? 4 : MY_CAPACITY_PLANE;
+    for (int i = 0; i < myEngine.cameras[cameraHandle].planeCount; i++)
+    {
+        const float sign = i % 2 ? -1.0f : 1.0f;
+        const MyVector normal = my_vector_add(clipW.normal, my_vector_scale(clipRows[i / 2].normal, my_vector_uniform(sign)));
+        const float length = my_vector_length(normal);
+        const float scale = length > 0.0f ? 1.0f / length : 0.0f;
+        myEngine.cameras[cameraHandle].planes[i] = (MyPlane)
+        {
+            my_vector_scale(normal, my_vector_uniform(scale)),
+            (clipW.distance + sign * clipRows[i / 2].distance) * scale
+        };
+    }
+    if (cameraHandle == myEngine.cameraHandle)
+    {
+        glNamedBufferSubData(myEngine.cameraBuffer, 0, MY_CAPACITY_CAMERA, &myEngine.cameras[cameraHandle].viewTransform);
+    }
+    myEngine.cameras[cameraHandle].dirty = false;
+}
+
+static bool my_camera_contains(MyVector minimum, MyVector maximum)
+{
+    const MyCamera* camera = &myEngine.cameras[myEngine.cameraHandle];
+    for (int i = 0; i < camera->planeCount; i++)
+    {
+        const MyVector corner =
+        {
+            camera->planes[i].normal.x >= 0.0f ? maximum.x : minimum.x,
+            camera->planes[i].normal.y >= 0.0f ? maximum.y : minimum.y,
+            camera->planes[i].normal.z >= 0.0f ? maximum.z : minimum.z
+        };
+        if (my_vector_dot(camera->planes[i].normal, corner) + camera->planes[i].distance < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Clock Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MyHandle my_clock_create(void)
+{
+    MyHandle clockHandle = MY_INVALID_HANDLE;
+    for (int i = 1; i < myEngine.clockCapacity; i++)
+    {
+        if (!myEngine.clocks[i].clockHandle)
+        {
+            clockHandle = i;
+            break;
+        }
+    }
+    if (!clockHandle)
+    {
+        MyClock* clocks = realloc(myEngine.clocks, (myEngine.clockCapacity + MY_ALLOCATOR_CLOCK) * sizeof(MyClock));
+        if (!clocks)
+        {
+            return MY_INVALID_HANDLE;
+        }
+        memset(clocks + myEngine.clockCapacity, 0, MY_ALLOCATOR_CLOCK * sizeof(MyClock));
+        clockHandle = myEngine.clockCapacity;
+        myEngine.clocks = clocks;
+        myEngine.clockCapacity += MY_ALLOCATOR_CLOCK;
+    }
+    myEngine.clocks[clockHandle].clockHandle = clockHandle;
+    return clockHandle;
+}
+
+void my_clock_destroy(MyHandle clockHandle)
+{
+    myEngine.clocks[clockHandle] = (MyClock) { 0 };
+}
+
+void my_clock_start(MyHandle clockHandle)
+{
+    myEngine.clocks[clockHandle].lastTime = (float) glfwGetTime();
+    myEngine.clocks[clockHandle].active = true;
+}
+
+void my_clock_stop(MyHandle clockHandle)
+{
+    myEngine.clocks[clockHandle].frameTime = 0.0f;
+    myEngine.clocks[clockHandle].active = false;
+}
+
+void my_clock_reset(MyHandle clockHandle)
+{
+    myEngine.clocks[clockHandle].lastTime = (float) glfwGetTime();
+    myEngine.clocks[clockHandle].totalTime = 0.0f;
+    myEngine.clocks[clockHandle].intervalTime = 0.0f;
+}
+
+void my_clock_set_interval(MyHandle clockHandle, float interval)
+{
+    myEngine.clocks[clockHandle].interval = interval;
+    myEngine.clocks[clockHandle].intervalTime = 0.0f;
+}
+
+void my_clock_set_callback(MyHandle clockHandle, MyClockCallback callback)
+{
+    myEngine.clocks[clockHandle].callback = callback;
+}
+
+float my_clock_get_time(MyHandle clockHandle)
+{
+    return myEngine.clocks[clockHandle].totalTime;
+}
+
+float my_clock_get_progress(MyHandle clockHandle)
+{
+    return myEngine.clocks[clockHandle].intervalTime / myEngine.clocks[clockHandle].interval;
+}
+
+static void my_clock_frame_callback(MyHandle clockHandle)
+{
+    myEngine.frameRate = myEngine.frameCount;
+    myEngine.frameCount = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Animation Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MyHandle my_animation_create(MyHandle entityHandle, const int* frameIndices, int frameCount, float frameDuration, MyAnimationMode mode)
+{
+    if (entityHandle <= 0 || entityHandle >= myEngine.entityCapacity || !myEngine.entities[entityHandle].entityHandle)
+    {
+        return MY_INVALID_HANDLE;
+    }
+    if (!frameIndices || frameCount <= 0)
+    {
+        return MY_INVALID_HANDLE;
+    }
+    MyHandle animationHandle = MY_INVALID_HANDLE;
+    for (int i = 1; i < myEngine.animationCapacity; i++)
+    {
+        if (!myEngine.animations[i].animationHandle)
+        {
+            animationHandle = i;
+            break;
+        }
+    }
+    if (!animationHandle)
+    {
+        MyAnimation* animations = realloc(myEngine.animations, (myEngine.animationCapacity + MY_ALLOCATOR_ANIMATION) * sizeof(MyAnimation));
+        if (!animations)
+        {
+            return MY_INVALID_HANDLE;
+        }
+        memset(animations + myEngine.animationCapacity, 0, MY_ALLOCATOR_ANIMATION * sizeof(MyAnimation));
+        animationHandle = myEngine.animationCapacity;
+        myEngine.animations = animations;
+        myEngine.animationCapacity += MY_ALLOCATOR_ANIMATION;
+    }
+    myEngine.animations[animationHandle].frameIndices = malloc(frameCount * sizeof(int));
+    if (!myEngine.animations[animationHandle].frameIndices)
+    {
+        return MY_INVALID_HANDLE;
+    }
+    memcpy(myEngine.animations[animationHandle].frameIndices, frameIndices, frameCount * sizeof(int));
+    if (myEngine.entities[entityHandle].animationHandle)
+    {
+        my_animation_destroy(myEngine.entities[entityHandle].animationHandle);
+    }
+    myEngine.animations[animationHandle].entityHandle = entityHandle;
+    myEngine.animations[animationHandle].clockHandle = MY_DEFAULT_CLOCK;
+    myEngine.animations[animationHandle].frameCount = frameCount;
+    myEngine.animations[animationHandle].frameDirection = 1;
+    myEngine.animations[animationHandle].frameDuration = fmaxf(frameDuration, FLT_EPSILON);
+    myEngine.animations[animationHandle].mode = mode;
+    myEngine.animations[animationHandle].animationHandle = animationHandle;
+    myEngine.entities[entityHandle].animationHandle = animationHandle;
+    my_entity_set_frame(entityHandle, frameIndices[0]);
+    return animationHandle;
+}
+
+void my_animation_destroy(MyHandle animationHandle)
+{
+    if (myEngine.animations[animationHandle].playing)
+    {
+        my_animation_erase(animationHandle);
+    }
+    if (myEngine.animations[animationHandle].frameIndices)
+    {
+        free(myEngine.animations[animationHandle].frameIndices);
+    }
+    myEngine.entities[myEngine.animations[animationHandle].entityHandle].animationHandle = MY_INVALID_HANDLE;
+    myEngine.animations[animationHandle] = (MyAnimation) { 0 };
+}
+
+bool my_animation_start(MyHandle animationHandle)
+{
+    if (myEngine.animations[animationHandle].playing)
+    {
+        return true;
+    }
+    return my_animation_insert(animationHandle);
+}
+
+void my_animation_stop(MyHandle animationHandle)
+{
+    if (myEngine.animations[animationHandle].playing)
+    {
+        my_animation_erase(animationHandle);
+    }
+}
+
+void my_animation_reset(MyHandle animationHandle)
+{
+    myEngine.animations[animationHandle].frameCursor = 0;
+    myEngine.animations[animationHandle].frameDirection = 1;
+    myEngine.animations[animationHandle].frameTime = 0.0f;
+    if (myEngine.animations[animationHandle].playing)
+    {
+        myEngine.playingTimes[myEngine.animations[animationHandle].playingIndex] = 0.0f;
+    }
+    my_entity_set_frame(myEngine.animations[animationHandle].entityHandle, myEngine.animations[animationHandle].frameIndices[0]);
+}
+
+void my_animation_set_clock(MyHandle animationHandle, MyHandle clockHandle)
+{
+    myEngine.animations[animationHandle].clockHandle = clockHandle;
+    if (myEngine.animations[animationHandle].playing)
+    {
+        myEngine.playingClocks[myEngine.animations[animationHandle].playingIndex] = clockHandle;
+    }
+}
+
+void my_animation_set_duration(MyHandle animationHandle, float frameDuration)
+{
+    myEngine.animations[animationHandle].frameDuration = fmaxf(frameDuration, FLT_EPSILON);
+    if (myEngine.animations[animationHandle].playing)
+    {
+        myEngine.playingDurations[myEngine.animations[animationHandle].playingIndex] = myEngine.animations[animationHandle].frameDuration;
+    }
+}
+
+bool my_animation_get_playing(MyHandle animationHandle)
+{
+    return myEngine.animations[animationHandle].playing;
+}
+
+static bool my_animation_insert(MyHandle animationHandle)
+{
+    if (myEngine.playingCount + 1 > myEngine.playingCapacity)
+    {
+        const int playingCapacity = myEngine.playingCapacity + MY_ALLOCATOR_ANIMATION;
+        MyHandle* playingHandles = realloc(myEngine.playingHandles, playingCapacity * sizeof(MyHandle));
+        if (!playingHandles)
+        {
+            return false;
+        }
+        myEngine.playingHandles = playingHandles;
+        MyHandle* playingClocks = realloc(myEngine.playingClocks, playingCapacity * sizeof(MyHandle));
+        if (!playingClocks)
+        {
+            return false;
+        }
+        myEngine.playingClocks = playingClocks;
+        float* playingTimes = realloc(myEngine.playingTimes, playingCapacity * sizeof(float));
+        if (!playingTimes)
+        {
+            return false;
+        }
+        myEngine.playingTimes = playingTimes;
+        float* playingDurations = realloc(myEngine.playingDurations, playingCapacity * sizeof(float));
+        if (!playingDurations)
+        {
+            return false;
+        }
+        myEngine.playingDurations = playingDurations;
+        myEngine.playingCapacity = playingCapacity;
+    }
+    const int playingIndex = myEngine.playingCount;
+    myEngine.playingHandles[playingIndex] = animationHandle;
+    myEngine.playingClocks[playingIndex] = myEngine.animations[animationHandle].clockHandle;
+    myEngine.playingTimes[playingIndex] = myEngine.animations[animationHandle].frameTime;
+    myEngine.playingDurations[playingIndex] = myEngine.animations[animationHandle].frameDuration;
+    myEngine.playingCount++;
+    myEngine.animations[animationHandle].playingIndex = playingIndex;
+    myEngine.animations[animationHandle].playing = true;
+    return true;
+}
+
+static void my_animation_erase(MyHandle animationHandle)
+{
+    const int playingIndex = myEngine.animations[animationHandle].playingIndex;
+    const int lastIndex = myEngine.playingCount - 1;
+    myEngine.animations[animationHandle].frameTime = myEngine.playingTimes[playingIndex];
+    myEngine.animations[animationHandle].playing = false;
+    myEngine.playingHandles[playingIndex] = myEngine.playingHandles[lastIndex];
+    myEngine.playingClocks[playingIndex] = myEngine.playingClocks[lastIndex];
+    myEngine.playingTimes[playingIndex] = myEngine.playingTimes[lastIndex];
+    myEngine.playingDurations[playingIndex] = myEngine.playingDurations[lastIndex];
+    myEngine.animations[myEngine.playingHandles[playingIndex]].playingIndex = playingIndex;
+    myEngine.playingCount--;
+}
+
+static void my_animation_advance(MyHandle animationHandle)
+{
+    const int playingIndex = myEngine.animations[animationHandle].playingIndex;
+    const int frameCount = myEngine.animations[animationHandle].frameCount;
+    const int stepCount = (int) (myEngine.playingTimes[playingIndex] / myEngine.playingDurations[playingIndex]);
+    myEngine.playingTimes[playingIndex] -= stepCount * myEngine.playingDurations[playingIndex];
+    int frameCursor = myEngine.animations[animationHandle].frameCursor;
+    if (myEngine.animations[animationHandle].mode == MY_ANIMATION_MODE_ONCE)
+    {
+        frameCursor = frameCursor + stepCount < frameCount - 1 ? frameCursor + stepCount : frameCount - 1;
+        if (frameCursor == frameCount - 1)
+        {
+            myEngine.playingTimes[playingIndex] = 0.0f;
+            my_animation_erase(animationHandle);
+        }
+    }
+    else if (myEngine.animations[animationHandle].mode == MY_ANIMATION_MODE_LOOP)
+    {
+        frameCursor = (frameCursor + stepCount) % frameCount;
+    }
+    else if (myEngine.animations[animationHandle].mode == MY_ANIMATION_MODE_PING_PONG && frameCount > 1)
+    {
+        const int period = 2 * (frameCount - 1);
+        int phase = myEngine.animations[animationHandle].frameDirection > 0 ? frameCursor : period - frameCursor;
+        phase = (phase + stepCount) % period;
+        myEngine.animations[animationHandle].frameDirection = phase < frameCount ? 1 : -1;
+        frameCursor = phase < frameCount ? phase : period - phase;
+    }
+    if (frameCursor != myEngine.animations[animationHandle].frameCursor)
+    {
+        myEngine.animations[animationHandle].frameCursor = frameCursor;
+        my_entity_set_frame(myEngine.animations[animationHandle].entityHandle, myEngine.animations[animationHandle].frameIndices[frameCursor]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Tilemap Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MyHandle my_tilemap_create(MyHandle textureHandle, int columnCount, int rowCount, float tileWidth, float tileHeight)
+{
+    if (columnCount <= 0 || rowCount <= 0)
+    {
+        return MY_INVALID_HANDLE;
+    }
+    if (textureHandle < 0 || textureHandle >= myEngine.textureCapacity || (textureHandle && !myEngine.textures[textureHandle].textureHandle))
+    {
+        return MY_INVALID_HANDLE;
+    }
+    MyHandle tilemapHandle = MY_INVALID_HANDLE;
+    for (int i = 1; i < myEngine.tilemapCapacity; i++)
+    {
+        if (!myEngine.tilemaps[i].tilemapHandle)
+        {
+            tilemapHandle = i;
+            break;
+        }
+    }
+    if (!tilemapHandle)
+    {
+        MyTilemap* tilemaps = realloc(myEngine.tilemaps, (myEngine.tilemapCapacity + MY_ALLOCATOR_TILEMAP) * sizeof(MyTilemap));
+        if (!tilemaps)
+        {
+            return MY_INVALID_HANDLE;
+        }
+        memset(tilemaps + myEngine.tilemapCapacity, 0, MY_ALLOCATOR_TILEMAP * sizeof(MyTilemap));
+        tilemapHandle = myEngine.tilemapCapacity;
+        myEngine.tilemaps = tilemaps;
+        myEngine.tilemapCapacity += MY_ALLOCATOR_TILEMAP;
+    }
+    const int chunkColumnCount = (columnCount + MY_CAPACITY_CHUNK - 1) / MY_CAPACITY_CHUNK;
+    const int chunkRowCount = (rowCount + MY_CAPACITY_CHUNK - 1) / MY_CAPACITY_CHUNK;
+    myEngine.tilemaps[tilemapHandle].chunks = calloc(chunkColumnCount * chunkRowCount, sizeof(MyChunk));
+    if (!myEngine.tilemaps[tilemapHandle].chunks)
+    {
+        return MY_INVALID_HANDLE;
+    }
+    myEngine.tilemaps[tilemapHandle].textureHandle = textureHandle;
+    myEngine.tilemaps[tilemapHandle].tileWidth = tileWidth;
+    myEngine.tilemaps[tilemapHandle].tileHeight = tileHeight;
+    myEngine.tilemaps[tilemapHandle].columnCount = columnCount;
+    myEngine.tilemaps[tilemapHandle].rowCount = rowCount;
+    myEngine.tilemaps[tilemapHandle].chunkColumnCount = chunkColumnCount;
+    myEngine.tilemaps[tilemapHandle].chunkRowCount = chunkRowCount;
+    myEngine.tilemaps[tilemapHandle].visible = true;
+    myEngine.tilemaps[tilemapHandle].tilemapHandle = tilemapHandle;
+    return tilemapHandle;
+}
+
+void my_tilemap_destroy(MyHandle tilemapHandle)
+{
+    if (myEngine.tilemaps[tilemapHandle].chunks)
+    {
+        for (int i = 0; i < myEngine.tilemaps[tilemapHandle].chunkColumnCount * myEngine.tilemaps[tilemapHandle].chunkRowCount; i++)
+        {
+            if (myEngine.tilemaps[tilemapHandle].chunks[i].instanceBuffer)
+            {
+                my_state_forget_buffer(myEngine.tilemaps[tilemapHandle].chunks[i].instanceBuffer);
+                glDeleteBuffers(1, &myEngine.tilemaps[tilemapHandle].chunks[i].instanceBuffer);
+            }
+        }
+        free(myEngine.tilemaps[tilemapHandle].chunks);
+    }
+    myEngine.tilemaps[tilemapHandle] = (MyTilemap) { 0 };
+}
+
+void my_tilemap_set_tile(MyHandle tilemapHandle, int column, int row, int frameIndex)
+{
+    if (column < 0 || column >= myEngine.tilemaps[tilemapHandle].columnCount)
+    {
+        return;
+    }
+    if (row < 0 || row >= myEngine.tilemaps[tilemapHandle].rowCount)
+    {
+        return;
+    }
+    if (frameIndex < -1 || frameIndex >= USHRT_MAX)
+    {
+        return;
+    }
+    MyChunk* chunk = &myEngine.tilemaps[tilemapHandle].chunks[row / MY_CAPACITY_CHUNK * myEngine.tilemaps[tilemapHandle].chunkColumnCount + column / MY_CAPACITY_CHUNK];
+    GLushort* tile = &chunk->tiles[row % MY_CAPACITY_CHUNK * MY_CAPACITY_CHUNK + column % MY_CAPACITY_CHUNK];
+    const GLushort value = (GLushort) (frameIndex + 1);
+    if (*tile != value)
+    {
+        *tile = value;
+        chunk->dirty = true;
+    }
+}
+
+void my_tilemap_set_texture(MyHandle tilemapHandle, MyHandle textureHandle)
+{
+    myEngine.tilemaps[tilemapHandle].textureHandle = textureHandle;
+    my_tilemap_mark(tilemapHandle);
+}
+
+void my_tilemap_set_position(MyHandle tilemapHandle, MyVector position)
+{
+    myEngine.tilemaps[tilemapHandle].position = position;
+    my_tilemap_mark(tilemapHandle);
+}
+
+void my_tilemap_set_visible(MyHandle tilemapHandle, bool visible)
+{
+    myEngine.tilemaps[tilemapHandle].visible = visible;
+}
+
+int my_tilemap_get_tile(MyHandle tilemapHandle, int column, int row)
+{
+    if (column < 0 || column >= myEngine.tilemaps[tilemapHandle].columnCount)
+    {
+        return -1;
+    }
+    if (row < 0 || row >= myEngine.tilemaps[tilemapHandle].rowCount)
+    {
+        return -1;
+    }
+    const MyChunk* chunk = &myEngine.tilemaps[tilemapHandle].chunks[row / MY_CAPACITY_CHUNK * myEngine.tilemaps[tilemapHandle].chunkColumnCount + column / MY_CAPACITY_CHUNK];
+    return chunk->tiles[row % MY_CAPACITY_CHUNK * MY_CAPACITY_CHUNK + column % MY_CAPACITY_CHUNK] - 1;
+}
+
+static void my_tilemap_mark(MyHandle tilemapHandle)
+{
+    for (int i = 0; i < myEngine.tilemaps[tilemapHandle].chunkColumnCount * myEngine.tilemaps[tilemapHandle].chunkRowCount; i++)
+    {
+        myEngine.tilemaps[tilemapHandle].chunks[i].dirty = true;
+    }
+}
+
+static void my_tilemap_refresh(MyHandle textureHandle)
+{
+    for (int i = 1; i < myEngine.tilemapCapacity; i++)
+    {
+        if (myEngine.tilemaps[i].tilemapHandle && myEngine.tilemaps[i].textureHandle == textureHandle)
+        {
+            my_tilemap_mark(i);
+        }
+    }
+}
+
+static void my_tilemap_unlink(MyHandle textureHandle)
+{
+    for (int i = 1; i < myEngine.tilemapCapacity; i++)
+    {
+        if (myEngine.tilemaps[i].tilemapHandle && myEngine.tilemaps[i].textureHandle == textureHandle)
+        {
+            myEngine.tilemaps[i].textureHandle = MY_INVALID_HANDLE;
+            my_tilemap_mark(i);
+        }
+    }
+}
+
+static bool my_tilemap_build(MyHandle tilemapHandle, int chunkIndex)
+{
+    MyChunk* chunk = &myEngine.tilemaps[tilemapHandle].chunks[chunkIndex];
+    const MyHandle textureHandle = myEngine.tilemaps[tilemapHandle].textureHandle;
+    const float tileWidth = myEngine.tilemaps[tilemapHandle].tileWidth;
+    const float tileHeight = myEngine.tilemaps[tilemapHandle].tileHeight;
+    const MyVector origin =
+    {
+        myEngine.tilemaps[tilemapHandle].position.x + chunkIndex % myEngine.tilemaps[tilemapHandle].chunkColumnCount * MY_CAPACITY_CHUNK * tileWidth,
+        myEngine.tilemaps[tilemapHandle].position.y + chunkIndex / myEngine.tilemaps[tilemapHandle].chunkColumnCount * MY_CAPACITY_CHUNK * tileHeight,
+        myEngine.tilemaps[tilemapHandle].position.z
+    };
+    MySpriteInstance instances[MY_CAPACITY_CHUNK * MY_CAPACITY_CHUNK];
+    int instanceCount = 0;
+    for (int i = 0; i < MY_CAPACITY_CHUNK * MY_CAPACITY_CHUNK; i++)
+    {
+        if (chunk->tiles[i])
+        {
+            instances[instanceCount] = (MySpriteInstance)
+            {
+                origin.x + (i % MY_CAPACITY_CHUNK + 0.5f) * tileWidth,
+                origin.y + (i / MY_CAPACITY_CHUNK + 0.5f) * tileHeight,
+                origin.z,
+                0.0f,
+                tileWidth,
+                tileHeight,
+                my_texture_slot(textureHandle, chunk->tiles[i] - 1)
+            };
+            instanceCount++;
+        }
+    }
+    if (instanceCount && !chunk->instanceBuffer)
+    {
+        glCreateBuffers(1, &chunk->instanceBuffer);
+        if (!chunk->instanceBuffer)
+        {
+            return false;
+        }
+        glNamedBufferStorage(chunk->instanceBuffer, sizeof(instances), NULL, GL_DYNAMIC_STORAGE_BIT);
+    }
+    if (instanceCount)
+    {
+        glNamedBufferSubData(chunk->instanceBuffer, 0, instanceCount * sizeof(MySpriteInstance), instances);
+    }
+    chunk->instanceCount = instanceCount;
+    chunk->dirty = false;
+    return true;
+}
+
+static bool my_tilemap_clip(MyHandle tilemapHandle, int chunkIndex)
+{
+    const float chunkWidth = MY_CAPACITY_CHUNK * myEngine.tilemaps[tilemapHandle].tileWidth;
+    const float chunkHeight = MY_CAPACITY_CHUNK * myEngine.tilemaps[tilemapHandle].tileHeight;
+    const MyVector minimum =
+    {
+        myEngine.tilemaps[tilemapHandle].position.x + chunkIndex % myEngine.tilemaps[tilemapHandle].chunkColumnCount * chunkWidth,
+        myEngine.tilemaps[tilemapHandle].position.y + chunkIndex / myEngine.tilemaps[tilemapHandle].chunkColumnCount * chunkHeight,
+        myEngine.tilemaps[tilemapHandle].position.z
+    };
+    return my_camera_contains(minimum, (MyVector) { minimum.x + chunkWidth, minimum.y + chunkHeight, minimum.z });
+}
+
+static void my_tilemap_draw(MyHandle tilemapHandle)
+{
+    const MyHandle textureHandle = myEngine.tilemaps[tilemapHandle].textureHandle;
+    const bool transparent = myEngine.textures[textureHandle].transparent;
+    bool bound = false;
+    for (int i = 0; i < myEngine.tilemaps[tilemapHandle].chunkColumnCount * myEngine.tilemaps[tilemapHandle].chunkRowCount; i++)
+    {
+        if (myEngine.culling && !my_tilemap_clip(tilemapHandle, i))
+        {
+            continue;
+        }
+        if (myEngine.tilemaps[tilemapHandle].chunks[i].dirty && !my_tilemap_build(tilemapHandle, i))
+        {
+            continue;
+        }
+        if (!myEngine.tilemaps[tilemapHandle].chunks[i].instanceCount)
+        {
+            continue;
+        }
+        if (!bound)
+        {
+            my_state_set_blend(transparent);
+            my_state_set_depth_mask(!transparent);
+            my_state_bind_vertex_format(myEngine.pools[MY_ENTITY_TYPE_SPRITE].vertexFormat);
+            my_state_bind_vertex_buffer(MY_ENTITY_TYPE_SPRITE, MY_BUFFER_ENTITY_VERTEX, myEngine.pools[MY_ENTITY_TYPE_SPRITE].vertexBuffer, 0, myEngine.pools[MY_ENTITY_TYPE_SPRITE].vertexSize);
+            my_state_bind_element_buffer(MY_ENTITY_TYPE_SPRITE, myEngine.pools[MY_ENTITY_TYPE_SPRITE].indexBuffer);
+            my_state_use_program(myEngine.shaders[MY_DEFAULT_SHADER_SPRITE].program);
+            if (!myEngine.bindless)
+            {
+                my_state_bind_texture(MY_SAMPLER_ENTITY, myEngine.buckets[myEngine.textures[textureHandle].bucketHandle].texture);
+            }
+            bound = true;
+        }
+        my_state_bind_vertex_buffer(MY_ENTITY_TYPE_SPRITE, MY_BUFFER_ENTITY_INSTANCE, myEngine.tilemaps[tilemapHandle].chunks[i].instanceBuffer, 0, sizeof(MySpriteInstance));
+        glDrawElementsInstanced(GL_TRIANGLES, sizeof(myQuadIndices) / sizeof(GLushort), GL_UNSIGNED_SHORT, NULL, myEngine.tilemaps[tilemapHandle].chunks[i].instanceCount);
+    }
+    if (bound && transparent)
+    {
+        my_state_set_blend(false);
+        my_state_set_depth_mask(true);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Voxel Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MyHandle my_voxel_create(MyHandle textureHandle, int chunkColumnCount, int chunkRowCount)
+{
+    if (chunkColumnCount <= 0 || chunkRowCount <= 0)
+    {
+        return MY_INVALID_HANDLE;
+    }
+    if (textureHandle < 0 || textureHandle >= myEngine.textureCapacity || (textureHandle && !myEngine.textures[textureHandle].textureHandle))
+    {
+        return MY_INVALID_HANDLE;
+    }
+    if (!myEngine.voxelRunning && !my_voxel_start())
+    {
+        return MY_INVALID_HANDLE;
+    }
+    MyHandle voxelHandle = MY_INVALID_HANDLE;
+    for (int i = 1; i < myEngine.voxelCapacity; i++)
+    {
+        if (!myEngine.voxels[i].voxelHandle)
+        {
+            voxelHandle = i;
+            break;
+        }
+    }
+    if (!voxelHandle)
+    {
+        MyVoxel* voxels = realloc(myEngine.voxels, (myEngine.voxelCapacity + MY_ALLOCATOR_VOXEL) * sizeof(MyVoxel));
+        if (!voxels)
+        {
+            return MY_INVALID_HANDLE;
+        }
+        memset(voxels + myEngine.voxelCapacity, 0, MY_ALLOCATOR_VOXEL * sizeof(MyVoxel));
+        voxelHandle = myEngine.voxelCapacity;
+        myEngine.voxels = voxels;
+        myEngine.voxelCapacity += MY_ALLOCATOR_VOXEL;
+    }
+    myEngine.voxels[voxelHandle].chunks = calloc(chunkColumnCount * chunkRowCount, sizeof(MyVoxelChunk));
+    if (!myEngine.voxels[voxelHandle].chunks)
+    {
+        return MY_INVALID_HANDLE;
+    }
+    myEngine.voxels[voxelHandle].textureHandle = textureHandle;
+    myEngine.voxels[voxelHandle].chunkColumnCount = chunkColumnCount;
+    myEngine.voxels[voxelHandle].chunkRowCount = chunkRowCount;
+    myEngine.voxels[voxelHandle].serial = ++myEngine.voxelSerial;
+    myEngine.voxels[voxelHandle].visible = true;
+    myEngine.voxels[voxelHandle].voxelHandle = voxelHandle;
+    return voxelHandle;
+}
+
+void my_voxel_destroy(MyHandle voxelHandle)
+{
+    if (myEngine.voxels[voxelHandle].chunks)
+    {
+        for (int i = 0; i < myEngine.voxels[voxelHandle].chunkColumnCount * myEngine.voxels[voxelHandle].chunkRowCount; i++)
+        {
+            if (myEngine.voxels[voxelHandle].chunks[i].vertexBuffer)
+            {
+                my_state_forget_buffer(myEngine.voxels[voxelHandle].chunks[i].vertexBuffer);
+                glDeleteBuffers(1, &myEngine.voxels[voxelHandle].chunks[i].vertexBuffer);
+            }
+        }
+        free(myEngine.voxels[voxelHandle].chunks);
+    }
+    myEngine.voxels[voxelHandle] = (MyVoxel) { 0 };
+}
+
+void my_voxel_set_block(MyHandle voxelHandle, int x, int y, int z, int frameIndex)
+{
+    if (x < 0 || x >= myEngine.voxels[voxelHandle].chunkColumnCount * MY_CAPACITY_VOXEL_X)
+    {
+        return;
+    }
+    if (y < 0 || y >= MY_CAPACITY_VOXEL_Y)
+    {
+        return;
+    }
+    if (z < 0 || z >= myEngine.voxels[voxelHandle].chunkRowCount * MY_CAPACITY_VOXEL_Z)
+    {
+        return;
+    }
+    if (frameIndex < -1 || frameIndex >= MY_CAPACITY_VOXEL_FRAME)
+    {
+        return;
+    }
+    MyVoxelChunk* chunk = &myEngine.voxels[voxelHandle].chunks[z / MY_CAPACITY_VOXEL_Z * myEngine.voxels[voxelHandle].chunkColumnCount + x / MY_CAPACITY_VOXEL_X];
+    GLushort* block = &chunk->blocks[y * MY_CAPACITY_VOXEL_X * MY_CAPACITY_VOXEL_Z + z % MY_CAPACITY_VOXEL_Z * MY_CAPACITY_VOXEL_X + x % MY_CAPACITY_VOXEL_X];
+    const GLushort value = (GLushort) (frameIndex + 1);
+    if (*block != value)
+    {
+        *block = value;
+        my_voxel_mark(voxelHandle, x, z);
+    }
+}
+
+void my_voxel_set_texture(MyHandle voxelHandle, MyHandle textureHandle)
+{
+    myEngine.voxels[voxelHandle].textureHandle = textureHandle;
+}
+
+void my_voxel_set_position(MyHandle voxelHandle, MyVector position)
+{
+    myEngine.voxels[voxelHandle].position = position;
+}
+
+void my_voxel_set_visible(MyHandle voxelHandle, bool visible)
+{
+    myEngine.voxels[voxelHandle].visible = visible;
+}
+
+int my_voxel_get_block(MyHandle voxelHandle, int x, int y, int z)
+{
+    return my_voxel_block(voxelHandle, x, y, z) - 1;
+}
+
+static bool my_voxel_start(void)
+{
+    if (!myEngine.voxelShader)
+    {
+        myEngine.voxelShader = my_shader_create(MY_PATH_ASSETS "/shaders/vertex/voxel.glsl", MY_PATH_ASSETS "/shaders/fragment/voxel.glsl");
+        if (!myEngine.voxelShader)
+        {
+            return false;
+        }
+    }
+    if (!my_mutex_create(&myEngine.voxelMutex))
+    {
+        return false;
+    }
+    if (!my_condition_create(&myEngine.voxelCondition))
+    {
+        my_mutex_destroy(&myEngine.voxelMutex);
+        return false;
+    }
+    myEngine.voxelQuit = false;
+    myEngine.voxelRunning = true;
+    for (int i = 0; i < MY_CAPACITY_WORKER; i++)
+    {
+        if (!my_thread_create(&myEngine.voxelThreads[myEngine.voxelThreadCount], my_voxel_work, NULL))
+        {
+            break;
+        }
+        myEngine.voxelThreadCount++;
+    }
+    if (!myEngine.voxelThreadCount)
+    {
+        my_voxel_stop();
+        return false;
+    }
+    return true;
+}
+
+static void my_voxel_stop(void)
+{
+    my_mutex_lock(&myEngine.voxelMutex);
+    myEngine.voxelQuit = true;
+    my_condition_broadcast(&myEngine.voxelCondition);
+    my_mutex_unlock(&myEngine.voxelMutex);
+    for (int i = 0; i < myEngine.voxelThreadCount; i++)
+    {
+        my_thread_join(myEngine.voxelThreads[i]);
+    }
+    myEngine.voxelThreadCount = 0;
+    while (myEngine.voxelQueueFirst)
+    {
+        MyVoxelJob* job = myEngine.voxelQueueFirst;
+        myEngine.voxelQueueFirst = job->next;
+        free(job->blocks);
+        free(job);
+    }
+    myEngine.voxelQueueLast = NULL;
+    while (myEngine.voxelResults)
+    {
+        MyVoxelJob* job = myEngine.voxelResults;
+        myEngine.voxelResults = job->next;
+        free(job->vertices);
+        free(job);
+    }
+    my_condition_destroy(&myEngine.voxelCondition);
+    my_mutex_destroy(&myEngine.voxelMutex);
+    myEngine.voxelRunning = false;
+}
+
+static GLushort my_voxel_block(MyHandle voxelHandle, int x, int y, int z)
+{
+    if (x < 0 || x >= myEngine.voxels[voxelHandle].chunkColumnCount * MY_CAPACITY_VOXEL_X)
+    {
+        return 0;
+    }
+    if (y < 0 || y >= MY_CAPACITY_VOXEL_Y)
+    {
+        return 0;
+    }
+    if (z < 0 || z >= myEngine.voxels[voxelHandle].chunkRowCount * MY_CAPACITY_VOXEL_Z)
+    {
+        return 0;
+    }
+    const MyVoxelChunk* chunk = &myEngine.voxels[voxelHandle].chunks[z / MY_CAPACITY_VOXEL_Z * myEngine.voxels[voxelHandle].chunkColumnCount + x / MY_CAPACITY_VOXEL_X];
+    return chunk->blocks[y * MY_CAPACITY_VOXEL_X * MY_CAPACITY_VOXEL_Z + z % MY_CAPACITY_VOXEL_Z * MY_CAPACITY_VOXEL_X + x % MY_CAPACITY_VOXEL_X];
+}
+
+static void my_voxel_mark(MyHandle voxelHandle, int x, int z)
+{
+    const int chunkColumn = x / MY_CAPACITY_VOXEL_X;
+    const int chunkRow = z / MY_CAPACITY_VOXEL_Z;
+    const int chunkColumnCount = myEngine.voxels[voxelHandle].chunkColumnCount;
+    myEngine.voxels[voxelHandle].chunks[chunkRow * chunkColumnCount + chunkColumn].dirty = true;
+    if (x % MY_CAPACITY_VOXEL_X == 0 && chunkColumn > 0)
+    {
+        myEngine.voxels[voxelHandle].chunks[chunkRow * chunkColumnCount + chunkColumn - 1].dirty = true;
+    }
+    if (x % MY_CAPACITY_VOXEL_X == MY_CAPACITY_VOXEL_X - 1 && chunkColumn < chunkColumnCount - 1)
+    {
+        myEngine.voxels[voxelHandle].chunks[chunkRow * chunkColumnCount + chunkColumn + 1].dirty = true;
+    }
+    if (z % MY_CAPACITY_VOXEL_Z == 0 && chunkRow > 0)
+    {
+        myEngine.voxels[voxelHandle].chunks[(chunkRow - 1) * chunkColumnCount + chunkColumn].dirty = true;
+    }
+    if (z % MY_CAPACITY_VOXEL_Z == MY_CAPACITY_VOXEL_Z - 1 && chunkRow < myEngine.voxels[voxelHandle].chunkRowCount - 1)
+    {
+        myEngine.voxels[voxelHandle].chunks[(chunkRow + 1) * chunkColumnCount + chunkColumn].dirty = true;
+    }
+}
+
+static void my_voxel_snapshot(MyHandle voxelHandle, int chunkIndex, GLushort* blocks)
+{
+    const MyVoxelChunk* chunk = &myEngine.voxels[voxelHandle].chunks[chunkIndex];
+    const int originX = chunkIndex % myEngine.voxels[voxelHandle].chunkColumnCount * MY_CAPACITY_VOXEL_X;
+    const int originZ = chunkIndex / myEngine.voxels[voxelHandle].chunkColumnCount * MY_CAPACITY_VOXEL_Z;
+    const int strideZ = MY_CAPACITY_VOXEL_X + 2;
+    const int strideY = (MY_CAPACITY_VOXEL_X + 2) * (MY_CAPACITY_VOXEL_Z + 2);
+    memset(blocks, 0, strideY * (MY_CAPACITY_VOXEL_Y + 2) * sizeof(GLushort));
+    for (int y = 0; y < MY_CAPACITY_VOXEL_Y; y++)
+    {
+        GLushort* layer = blocks + (y + 1) * strideY + strideZ + 1;
+        for (int z = 0; z < MY_CAPACITY_VOXEL_Z; z++)
+        {
+            memcpy(layer + z * strideZ, chunk->blocks + y * MY_CAPACITY_VOXEL_X * MY_CAPACITY_VOXEL_Z + z * MY_CAPACITY_VOXEL_X, MY_CAPACITY_VOXEL_X * sizeof(GLushort));
+            layer[z * strideZ - 1] = my_voxel_block(voxelHandle, originX - 1, y, originZ + z);
+            layer[z * strideZ + MY_CAPACITY_VOXEL_X] = my_voxel_block(voxelHandle, originX + MY_CAPACITY_VOXEL_X, y, originZ + z);
+        }
+        for (int x = 0; x < MY_CAPACITY_VOXEL_X; x++)
+        {
+            layer[x - strideZ] = my_voxel_block(voxelHandle, originX + x, y, originZ - 1);
+            layer[x + MY_CAPACITY_VOXEL_Z * strideZ] = my_voxel_block(voxelHandle, originX + x, y, originZ + MY_CAPACITY_VOXEL_Z);
+        }
+    }
+}
+
+static void my_voxel_dispatch(MyHandle voxelHandle)
+{
+    const size_t blockSize = (MY_CAPACITY_VOXEL_X + 2) * (MY_CAPACITY_VOXEL_Y + 2) * (MY_CAPACITY_VOXEL_Z + 2) * sizeof(GLushort);
+    for (int i = 0; i < myEngine.voxels[voxelHandle].chunkColumnCount * myEngine.voxels[voxelHandle].chunkRowCount; i++)
+    {
+        MyVoxelChunk* chunk = &myEngine.voxels[voxelHandle].chunks[i];
+        if (!chunk->dirty || chunk->meshing)
+        {
+            continue;
+        }
+        MyVoxelJob* job = calloc(1, sizeof(MyVoxelJob));
+        if (!job)
+        {
+            return;
+        }
+        job->blocks = malloc(blockSize);
+        if (!job->blocks)
+        {
+            free(job);
+            return;
+        }
+        my_voxel_snapshot(voxelHandle, i, job->blocks);
+        job->voxelHandle = voxelHandle;
+        job->chunkIndex = i;
+        job->serial = myEngine.voxels[voxelHandle].serial;
+        chunk->dirty = false;
+        chunk->meshing = true;
+        my_mutex_lock(&myEngine.voxelMutex);
+        if (myEngine.voxelQueueLast)
+        {
+            myEngine.voxelQueueLast->next = job;
+        }
+        else
+        {
+            myEngine.voxelQueueFirst = job;
+        }
+        myEngine.voxelQueueLast = job;
+        my_condition_broadcast(&myEngine.voxelCondition);
+        my_mutex_unlock(&myEngine.voxelMutex);
+    }
+}
+
+static void my_voxel_collect(void)
+{
+    my_mutex_lock(&myEngine.voxelMutex);
+    MyVoxelJob* job = myEngine.voxelResults;
+    myEngine.voxelResults = NULL;
+    my_mutex_unlock(&myEngine.voxelMutex);
+    while (job)
+    {
+        MyVoxelJob* next = job->next;
+        const MyHandle voxelHandle = job->voxelHandle;
+        if (myEngine.voxels[voxelHandle].voxelHandle && myEngine.voxels[voxelHandle].serial == job->serial)
+        {
+            MyVoxelChunk* chunk = &myEngine.voxels[voxelHandle].chunks[job->chunkIndex];
+            chunk->meshing = false;
+            if (job->failed || !my_voxel_upload(voxelHandle, job->chunkIndex, job->vertices, job->vertexCount))
+            {
+                chunk->dirty = true;
+            }
+        }
+        free(job->vertices);
+        free(job);
+        job = next;
+    }
+}
+
+static bool my_voxel_upload(MyHandle voxelHandle, int chunkIndex, const GLuint* vertices, int vertexCount)
+{
+    MyVoxelChunk* chunk = &myEngine.voxels[voxelHandle].chunks[chunkIndex];
+    if (!my_voxel_reserve(vertexCount / 4))
+    {
+        return false;
+    }
+    if (vertexCount > chunk->vertexCapacity)
+    {
+        int vertexCapacity = chunk->vertexCapacity ? chunk->vertexCapacity : MY_ALLOCATOR_VOXEL_VERTEX;
+        while (vertexCapacity < vertexCount)
+        {
+            vertexCapacity *= 2;
+        }
+        GLuint vertexBuffer = 0;
+        glCreateBuffers(1, &vertexBuffer);
+        if (!vertexBuffer)
+        {
+            return false;
+        }
+        glNamedBufferStorage(vertexBuffer, vertexCapacity * sizeof(GLuint), NULL, GL_DYNAMIC_STORAGE_BIT);
+        if (chunk->vertexBuffer)
+        {
+            my_state_forget_buffer(chunk->vertexBuffer);
+            glDeleteBuffers(1, &chunk->vertexBuffer);
+        }
+        chunk->vertexBuffer = vertexBuffer;
+        chunk->vertexCapacity = vertexCapacity;
+    }
+    if (vertexCount)
+    {
+        glNamedBufferSubData(chunk->vertexBuffer, 0, vertexCount * sizeof(GLuint), vertices);
+    }
+    chunk->vertexCount = vertexCount;
+    return true;
+}
+
+static bool my_voxel_reserve(int quadCount)
+{
+    const int quadSize = 6 * sizeof(GLuint);
+    if (quadCount * quadSize <= myEngine.pools[MY_ENTITY_TYPE_VOXEL].indexCapacity)
+    {
+        return true;
+    }
+    int quadCapacity = myEngine.pools[MY_ENTITY_TYPE_VOXEL].indexCapacity ? myEngine.pools[MY_ENTITY_TYPE_VOXEL].indexCapacity / quadSize : MY_ALLOCATOR_VOXEL_QUAD;
+    while (quadCapacity < quadCount)
+    {
+        quadCapacity *= 2;
+    }
+    GLuint* indices = malloc(quadCapacity * quadSize);
+    if (!indices)
+    {
+        return false;
+    }
+    for (int i = 0; i < quadCapacity; i++)
+    {
+        for (int j = 0; j < 6; j++)
+        {
+            indices[i * 6 + j] = i * 4 + myQuadIndices[j];
+        }
+    }
+    GLuint indexBuffer = 0;
+    glCreateBuffers(1, &indexBuffer);
+    if (!indexBuffer)
+    {
+        free(indices);
+        return false;
+    }
+    glNamedBufferStorage(indexBuffer, quadCapacity * quadSize, indices, 0);
+    free(indices);
+    if (myEngine.pools[MY_ENTITY_TYPE_VOXEL].indexBuffer)
+    {
+        my_state_forget_buffer(myEngine.pools[MY_ENTITY_TYPE_VOXEL].indexBuffer);
+        glDeleteBuffers(1, &myEngine.pools[MY_ENTITY_TYPE_VOXEL].indexBuffer);
+    }
+    myEngine.pools[MY_ENTITY_TYPE_VOXEL].indexBuffer = indexBuffer;
+    myEngine.pools[MY_ENTITY_TYPE_VOXEL].indexCapacity = quadCapacity * quadSize;
+    return true;
+}
+
+static MyThreadResult MY_THREAD_CALL my_voxel_work(void* argument)
+{
+    (void) argument;
+    my_mutex_lock(&myEngine.voxelMutex);
+    while (true)
+    {
+        while (!myEngine.voxelQuit && !myEngine.voxelQueueFirst)
+        {
+            my_condition_wait(&myEngine.voxelCondition, &myEngine.voxelMutex);
+        }
+        if (myEngine.voxelQuit)
+        {
+            break;
+        }
+        MyVoxelJob* job = myEngine.voxelQueueFirst;
+        myEngine.voxelQueueFirst = job->next;
+        if (!myEngine.voxelQueueFirst)
+        {
+            myEngine.voxelQueueLast = NULL;
+        }
+        my_mutex_unlock(&myEngine.voxelMutex);
+        job->failed = !my_voxel_mesh(job);
+        free(job->blocks);
+        job->blocks = NULL;
+        my_mutex_lock(&myEngine.voxelMutex);
+        job->next = myEngine.voxelResults;
+        myEngine.voxelResults = job;
+    }
+    my_mutex_unlock(&myEngine.voxelMutex);
+    return 0;
+}
+
+static bool my_voxel_mesh(MyVoxelJob* job)
+{
+    const int sizes[3] = { MY_CAPACITY_VOXEL_X, MY_CAPACITY_VOXEL_Y, MY_CAPACITY_VOXEL_Z };
+    const int strides[3] = { 1, (MY_CAPACITY_VOXEL_X + 2) * (MY_CAPACITY_VOXEL_Z + 2), MY_CAPACITY_VOXEL_X + 2 };
+    GLushort mask[MY_CAPACITY_VOXEL_X * MY_CAPACITY_VOXEL_Y];
+    for (int axis = 0; axis < 3; axis++)
+    {
+        const int u = (axis + 1) % 3;
+        const int v = (axis + 2) % 3;
+        for (int side = 0; side < 2; side++)
+        {
+            const int step = side ? strides[axis] : -strides[axis];
+            for (int slice = 0; slice < sizes[axis]; slice++)
+            {
+                int position[3];
+                position[axis] = slice;
+                for (position[v] = 0; position[v] < sizes[v]; position[v]++)
+                {
+                    for (position[u] = 0; position[u] < sizes[u]; position[u]++)
+                    {
+                        const int index = (position[0] + 1) * strides[0] + (position[1] + 1) * strides[1] + (position[2] + 1) * strides[2];
+                        const GLushort block = job->blocks[index];
+                        mask[position[v] * sizes[u] + position[u]] = block && !job->blocks[index + step] ? block : 0;
+                    }
+                }
+                for (int j = 0; j < sizes[v]; j++)
+                {
+                    for (int i = 0; i < sizes[u];)
+                    {
+                        const GLushort block = mask[j * sizes[u] + i];
+                        if (!block)
+                        {
+                            i++;
+                            continue;
+                        }
+                        int width = 1;
+                        while (i + width < sizes[u] && mask[j * sizes[u] + i + width] == block)
+                        {
+                            width++;
+                        }
+                        int height = 1;
+                        for (; j + height < sizes[v]; height++)
+                        {
+                            int k = 0;
+                            while (k < width && mask[(j + height) * sizes[u] + i + k] == block)
+                            {
+                                k++;
+                            }
+                            if (k < width)
+                            {
+                                break;
+                            }
+                        }
+                        for (int k = 0; k < height; k++)
+                        {
+                            memset(&mask[(j + k) * sizes[u] + i], 0, width * sizeof(GLushort));
+                        }
+                        int corners[4][3];
+                        for (int k = 0; k < 4; k++)
+                        {
+                            corners[k][axis] = slice + side;
+                            corners[k][u] = i + (k == 1 || k == 2 ? width : 0);
+                            corners[k][v] = j + (k == 2 || k == 3 ? height : 0);
+                        }
+                        const int face = axis * 2 + side;
+                        for (int k = 0; k < 4; k++)
+                        {
+                            if (!my_voxel_emit(job, corners[side ? k : (4 - k) % 4], face, block))
+                            {
+                                return false;
+                            }
+                        }
+                        i += width;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static bool my_voxel_emit(MyVoxelJob* job, const int* corner, int face, GLushort block)
+{
+    if (job->vertexCount == job->vertexCapacity)
+    {
+        const int vertexCapacity = job->vertexCapacity ? job->vertexCapacity * 2 : MY_ALLOCATOR_VOXEL_VERTEX;
+        GLuint* vertices = realloc(job->vertices, vertexCapacity * sizeof(GLuint));
+        if (!vertices)
+        {
+            return false;
+        }
+        job->vertices = vertices;
+        job->vertexCapacity = vertexCapacity;
+    }
+    job->vertices[job->vertexCount] = (GLuint) corner[0] | (GLuint) corner[1] << 5 | (GLuint) corner[2] << 14 | (GLuint) face << 19 | (GLuint) (block & 0x3FF) << 22;
+    job->vertexCount++;
+    return true;
+}
+
+static void my_voxel_draw(MyHandle voxelHandle)
+{
+    const MyHandle textureHandle = myEngine.voxels[voxelHandle].textureHandle;
+    const GLuint program = myEngine.shaders[myEngine.voxelShader].program;
+    bool bound = false;
+    for (int i = 0; i < myEngine.voxels[voxelHandle].chunkColumnCount * myEngine.voxels[voxelHandle].chunkRowCount; i++)
+    {
+        const MyVoxelChunk* chunk = &myEngine.voxels[voxelHandle].chunks[i];
+        if (!chunk->vertexCount)
+        {
+            continue;
+        }
+        const MyVector origin =
+        {
+            myEngine.voxels[voxelHandle].position.x + i % myEngine.voxels[voxelHandle].chunkColumnCount * MY_CAPACITY_VOXEL_X,
+            myEngine.voxels[voxelHandle].position.y,
+            myEngine.voxels[voxelHandle].position.z + i / myEngine.voxels[voxelHandle].chunkColumnCount * MY_CAPACITY_VOXEL_Z
+        };
+        if (myEngine.culling && !my_camera_contains(origin, (MyVector) { origin.x + MY_CAPACITY_VOXEL_X, origin.y + MY_CAPACITY_VOXEL_Y, origin.z + MY_CAPACITY_VOXEL_Z }))
+        {
+            continue;
+        }
+        if (!bound)
+        {
+            my_state_bind_vertex_format(myEngine.pools[MY_ENTITY_TYPE_VOXEL].vertexFormat);
+            my_state_bind_element_buffer(MY_ENTITY_TYPE_VOXEL, myEngine.pools[MY_ENTITY_TYPE_VOXEL].indexBuffer);
+            my_state_use_program(program);
+            if (!myEngine.bindless && textureHandle)
+            {
+                my_state_bind_texture(MY_SAMPLER_ENTITY, myEngine.buckets[myEngine.textures[textureHandle].bucketHandle].texture);
+            }
+            glProgramUniform1ui(program, MY_UNIFORM_VOXEL_FRAME, my_texture_slot(textureHandle, 0));
+            glProgramUniform1ui(program, MY_UNIFORM_VOXEL_COUNT, myEngine.textures[textureHandle].textureHandle ? myEngine.textures[textureHandle].frameCount : 0);
+            bound = true;
+        }
+        glProgramUniform3f(program, MY_UNIFORM_VOXEL_ORIGIN, origin.x, origin.y, origin.z);
+        my_state_bind_vertex_buffer(MY_ENTITY_TYPE_VOXEL, MY_BUFFER_ENTITY_VERTEX, chunk->vertexBuffer, 0, myEngine.pools[MY_ENTITY_TYPE_VOXEL].vertexSize);
+        glDrawElements(GL_TRIANGLES, chunk->vertexCount / 4 * 6, GL_UNSIGNED_INT, NULL);
+    }
+}
+
+static void my_voxel_unlink(MyHandle textureHandle)
+{
+    for (int i = 1; i < myEngine.voxelCapacity; i++)
+    {
+        if (myEngine.voxels[i].voxelHandle && myEngine.voxels[i].textureHandle == textureHandle)
+        {
+            myEngine.voxels[i].textureHandle = MY_INVALID_HANDLE;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Layer Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MyHandle my_layer_create(MyHandle cameraHandle, int width, int height)
+{
+    if (!myEngine.layerShader)
+    {
+        myEngine.layerShader = my_shader_create(MY_PATH_ASSETS "/shaders/vertex/layer.glsl", MY_PATH_ASSETS "/shaders/fragment/layer.glsl");
+        if (!myEngine.layerShader)
+        {
+            return MY_INVALID_HANDLE;
+        }
+    }
+    if (!myEngine.layerFormat)
+    {
+        glCreateVertexArrays(1, &myEngine.layerFormat);
+        if (!myEngine.layerFormat)
+        {
+            return MY_INVALID_HANDLE;
+        }
+    }
+    MyHandle layerHandle = MY_INVALID_HANDLE;
+    for (int i = 1; i < myEngine.layerCapacity; i++)
+    {
+        if (!myEngine.layers[i].layerHandle)
+        {
+            layerHandle = i;
+            break;
+        }
+    }
+    if (!layerHandle)
+    {
+        MyLayer* layers = realloc(myEngine.layers, (myEngine.layerCapacity + MY_ALLOCATOR_LAYER) * sizeof(MyLayer));
+        if (!layers)
+        {
+            return MY_INVALID_HANDLE;
+        }
+        memset(layers + myEngine.layerCapacity, 0, MY_ALLOCATOR_LAYER * sizeof(MyLayer));
+        layerHandle = myEngine.layerCapacity;
+        myEngine.layers = layers;
+        myEngine.layerCapacity += MY_ALLOCATOR_LAYER;
+    }
+    glCreateFramebuffers(1, &myEngine.layers[layerHandle].framebuffer);
+    glCreateTextures(GL_TEXTURE_2D, 1, &myEngine.layers[layerHandle].colorTexture);
+    glCreateRenderbuffers(1, &myEngine.layers[layerHandle].depthBuffer);
+    if (!myEngine.layers[layerHandle].framebuffer || !myEngine.layers[layerHandle].colorTexture || !myEngine.layers[layerHandle].depthBuffer)
+    {
+        my_layer_destroy(layerHandle);
+        return MY_INVALID_HANDLE;
+    }
+    glTextureStorage2D(myEngine.layers[layerHandle].colorTexture, 1, GL_RGBA8, width, height);
+    glTextureParameteri(myEngine.layers[layerHandle].colorTexture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(myEngine.layers[layerHandle].colorTexture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(myEngine.layers[layerHandle].colorTexture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTextureParameteri(myEngine.layers[layerHandle].colorTexture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glNamedRenderbufferStorage(myEngine.layers[layerHandle].depthBuffer, GL_DEPTH_COMPONENT24, width, height);
+    glNamedFramebufferTexture(myEngine.layers[layerHandle].framebuffer, GL_COLOR_ATTACHMENT0, myEngine.layers[layerHandle].colorTexture, 0);
+    glNamedFramebufferRenderbuffer(myEngine.layers[layerHandle].framebuffer, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, myEngine.layers[layerHandle].depthBuffer);
+    if (glCheckNamedFramebufferStatus(myEngine.layers[layerHandle].framebuffer, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        my_layer_destroy(layerHandle);
+        return MY_INVALID_HANDLE;
+    }
+    myEngine.layers[layerHandle].cameraHandle = cameraHandle;
+    myEngine.layers[layerHandle].width = width;
+    myEngine.layers[layerHandle].height = height;
+    myEngine.layers[layerHandle].dirty = true;
+    myEngine.layers[layerHandle].visible = true;
+    myEngine.layers[layerHandle].layerHandle = layerHandle;
+    return layerHandle;
+}
+
+void my_layer_destroy(MyHandle layerHandle)
+{
+    for (int i = 1; i < myEngine.entityCapacity; i++)
+    {
+        if (myEngine.entities[i].entityHandle && myEngine.entities[i].layerHandle == layerHandle)
+        {
+            my_entity_set_layer(i, MY_INVALID_HANDLE);
+        }
+    }
+    if (myEngine.layers[layerHandle].framebuffer)
+    {
+        glDeleteFramebuffers(1, &myEngine.layers[layerHandle].framebuffer);
+    }
+    if (myEngine.layers[layerHandle].colorTexture)
+    {
+        my_state_forget_texture(myEngine.layers[layerHandle].colorTexture);
+        glDeleteTextures(1, &myEngine.layers[layerHandle].colorTexture);
+    }
+    if (myEngine.layers[layerHandle].depthBuffer)
+    {
+        glDeleteRenderbuffers(1, &myEngine.layers[layerHandle].depthBuffer);
+    }
+    myEngine.layers[layerHandle] = (MyLayer) { 0 };
+}
+
+void my_layer_redraw(MyHandle layerHandle)
+{
+    myEngine.layers[layerHandle].dirty = true;
+}
+
+void my_layer_set_camera(MyHandle layerHandle, MyHandle cameraHandle)
+{
+    myEngine.layers[layerHandle].cameraHandle = cameraHandle;
+    myEngine.layers[layerHandle].dirty = true;
+}
+
+void my_layer_set_visible(MyHandle layerHandle, bool visible)
+{
+    myEngine.layers[layerHandle].visible = visible;
+}
+
+void my_layer_set_front(MyHandle layerHandle, bool front)
+{
+    myEngine.layers[layerHandle].front = front;
+}
+
+static void my_layer_render(MyHandle layerHandle, int batchCount)
+{
+    const MyHandle cameraHandle = myEngine.layers[layerHandle].cameraHandle ? myEngine.layers[layerHandle].cameraHandle : myEngine.cameraHandle;
+    const GLuint framebuffer = myEngine.layers[layerHandle].framebuffer;
+    if (cameraHandle != myEngine.cameraHandle)
+    {
+        if (myEngine.cameras[cameraHandle].dirty)
+        {
+            my_camera_update(cameraHandle);
+        }
+        glNamedBufferSubData(myEngine.cameraBuffer, 0, MY_CAPACITY_CAMERA, &myEngine.cameras[cameraHandle].viewTransform);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, myEngine.layers[layerHandle].width, myEngine.layers[layerHandle].height);
+    my_state_set_depth_mask(true);
+    glClearNamedFramebufferfv(framebuffer, GL_COLOR, 0, (const GLfloat[]) { 0.0f, 0.0f, 0.0f, 0.0f });
+    glClearNamedFramebufferfv(framebuffer, GL_DEPTH, 0, (const GLfloat[]) { 1.0f });
+    my_state_set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    my_batch_draw(batchCount, layerHandle);
+    my_state_set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glBindFramebuffer(GL_FRAMEBUFFER, myEngine.sceneFramebuffer);
+    my_window_set_viewport(myEngine.viewportX, myEngine.viewportY, myEngine.viewportWidth, myEngine.viewportHeight);
+    if (cameraHandle != myEngine.cameraHandle)
+    {
+        glNamedBufferSubData(myEngine.cameraBuffer, 0, MY_CAPACITY_CAMERA, &myEngine.cameras[myEngine.cameraHandle].viewTransform);
+    }
+    myEngine.layers[layerHandle].dirty = false;
+}
+
+static void my_layer_composite(bool front)
+{
+    bool bound = false;
+    for (int i = 1; i < myEngine.layerCapacity; i++)
+    {
+        if (!myEngine.layers[i].layerHandle || !myEngine.layers[i].visible || myEngine.layers[i].front != front)
+        {
+            continue;
+        }
+        if (!bound)
+        {
+            my_state_set_blend_func(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            my_state_set_blend(true);
+            my_state_set_depth_mask(false);
+            my_state_bind_vertex_format(myEngine.layerFormat);
+            my_state_use_program(myEngine.shaders[myEngine.layerShader].program);
+            bound = true;
+        }
+        my_state_bind_texture(MY_SAMPLER_ENTITY, myEngine.layers[i].colorTexture);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+    if (bound)
+    {
+        my_state_set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        my_state_set_blend(false);
+        my_state_set_depth_mask(true);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Float Functions
+////////////////////////////////////////////////////////////////////////////////
+
+float my_float_randomize(float floor, float ceiling)
+{
+    const float range = ceiling - floor;
+    return (float) rand() / RAND_MAX * range + floor;
+}
+
+float my_float_clamp(float value, float floor, float ceiling)
+{
+    if (value < floor)
+    {
+        return floor;
+    }
+    if (value > ceiling)
+    {
+        return ceiling;
+    }
+    return value;
+}
+
+float my_float_wrap(float value, float floor, float ceiling)
+{
+    const float range = ceiling - floor;
+    while (value < floor)
+    {
+        value += range;
+    }
+    while (value > ceiling)
+    {
+        value -= range;
+    }
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Color Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MyColor my_color_uniform(float value, bool alpha)
+{
+    return (MyColor)
+    {
+        value,
+        value,
+        value,
+        alpha ? value : 1.0f
+    };
+}
+
+MyColor my_color_randomize(bool alpha)
+{
+    return (MyColor)
+    {
+        (float) rand() / RAND_MAX,
+        (float) rand() / RAND_MAX,
+        (float) rand() / RAND_MAX,
+        alpha ? (float) rand() / RAND_MAX : 1.0f
+    };
+}
+
+MyColor my_color_clamp(MyColor color)
+{
+    return (MyColor)
+    {
+        my_float_clamp(color.red, 0.0f, 1.0f),
+        my_float_clamp(color.green, 0.0f, 1.0f),
+        my_float_clamp(color.blue, 0.0f, 1.0f),
+        my_float_clamp(color.alpha, 0.0f, 1.0f)
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Vector Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MyVector my_vector_uniform(float value)
+{
+    return (MyVector)
+    {
+        value,
+        value,
+        value
+    };
+}
+
+MyVector my_vector_randomize(MyVector floor, MyVector ceiling)
+{
+    return (MyVector)
+    {
+        my_float_randomize(floor.x, ceiling.x),
+        my_float_randomize(floor.y, ceiling.y),
+        my_float_randomize(floor.z, ceiling.z)
+    };
+}
+
+MyVector my_vector_add(MyVector lhs, MyVector rhs)
+{
+    return (MyVector)
+    {
+        lhs.x + rhs.x,
+        lhs.y + rhs.y,
+        lhs.z + rhs.z
+    };
+}
+
+MyVector my_vector_subtract(MyVector lhs, MyVector rhs)
+{
+    return (MyVector)
+    {
+        lhs.x - rhs.x,
+        lhs.y - rhs.y,
+        lhs.z - rhs.z
+    };
+}
+
+MyVector my_vector_scale(MyVector vector, MyVector scale)
+{
+    return (MyVector)
+    {
+        vector.x * scale.x,
+        vector.y * scale.y,
+        vector.z * scale.z
+    };
+}
+
+MyVector my_vector_negate(MyVector vector)
+{
+    return (MyVector)
+    {
+        -vector.x,
+        -vector.y,
+        -vector.z,
+    };
+}
+
+float my_vector_length(MyVector vector)
+{
+    return sqrtf(vector.x * vector.x + vector.y * vector.y + vector.z * vector.z);
+}
+
+MyVector my_vector_normalize(MyVector vector)
+{
+    const float length = my_vector_length(vector);
+    if (length == 0.0f)
+    {
+        return MY_VECTOR_ZERO;
+    }
+    return my_vector_scale(vector, my_vector_uniform(1.0f / length));
+}
+
+float my_vector_dot(MyVector lhs, MyVector rhs)
+{
+    return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z;
+}
+
+MyVector my_vector_cross(MyVector lhs, MyVector rhs)
+{
+    return (MyVector)
+    {
+        lhs.y * rhs.z - lhs.z * rhs.y,
+        lhs.z * rhs.x - lhs.x * rhs.z,
+        lhs.x * rhs.y - lhs.y * rhs.x
+    };
+}
+
+MyVector my_vector_rotate(MyVector vector, MyVector rotation)
+{
+    if (rotation.x)
+    {
+        const float radians = rotation.x * MY_FLOAT_RADIANS;
+        const float cosRadians = cosf(radians);
+        const float sinRadians = sinf(radians);
+        vector = (MyVector)
+        {
+            vector.x,
+            vector.y * cosRadians + vector.z * -sinRadians,
+            vector.y * sinRadians + vector.z * cosRadians
+        };
+    }
+    if (rotation.y)
+    {
+        const float radians = rotation.y * MY_FLOAT_RADIANS;
+        const float cosRadians = cosf(radians);
+        const float sinRadians = sinf(radians);
+        vector = (MyVector)
+        {
+            vector.x * cosRadians + vector.z * sinRadians,
+            vector.y,
+            vector.x * -sinRadians + vector.z * cosRadians
+        };
+    }
+    if (rotation.z)
+    {
+        const float radians = rotation.z * MY_FLOAT_RADIANS;
+        const float cosRadians = cosf(radians);
+        const float sinRadians = sinf(radians);
+        vector = (MyVector)
+        {
+            vector.x * cosRadians + vector.y * -sinRadians,
+            vector.x * sinRadians + vector.y * cosRadians,
+            vector.z
+        };
+    }
+    return vector;
+}
+
+MyVector my_vector_clamp(MyVector vector, MyVector floor, MyVector ceiling)
+{
+    return (MyVector)
+    {
+        my_float_clamp(vector.x, floor.x, ceiling.x),
+        my_float_clamp(vector.y, floor.y, ceiling.y),
+        my_float_clamp(vector.z, floor.z, ceiling.z)
+    };
+}
+
+MyVector my_vector_wrap(MyVector vector, MyVector floor, MyVector ceiling)
+{
+    return (MyVector)
+    {
+        my_float_wrap(vector.x, floor.x, ceiling.x),
+        my_float_wrap(vector.y, floor.y, ceiling.y),
+        my_float_wrap(vector.z, floor.z, ceiling.z)
+    };
+}
+
+void my_vector_basis(MyVector* basisX, MyVector* basisY, MyVector* basisZ, MyVector rotation)
+{
+    *basisZ = my_vector_normalize(my_vector_rotate(MY_VECTOR_BASIS_Z, rotation));
+    *basisX = my_vector_normalize(my_vector_cross(*basisZ, MY_VECTOR_BASIS_Y));
+    *basisY = my_vector_normalize(my_vector_cross(*basisX, *basisZ));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Transform Functions
+////////////////////////////////////////////////////////////////////////////////
+
+MyTransform my_transform_compose(MyVector position, MyVector scale, MyVector rotation)
+{
+    MyTransform transform = my_transform_scale(MY_TRANSFORM_IDENTITY, scale);
+    transform = my_transform_rotate(transform, rotation);
+    transform = my_transform_translate(transform, position);
+    return transform;
+}
+
+MyTransform my_transform_multiply(MyTransform lhs, MyTransform rhs)
+{
+    return (MyTransform)
+    {
+        lhs.m1 * rhs.m1 + lhs.m2 * rhs.m5 + lhs.m3 * rhs.m9  + lhs.m4 * rhs.m13,
+        lhs.m5 * rhs.m1 + lhs.m6 * rhs.m5 + lhs.m7 * rhs.m9  + lhs.m8 * rhs.m13,
+        lhs.m9 * rhs.m1 + lhs.m10 * rhs.m5 + lhs.m11 * rhs.m9  + lhs.m12 * rhs.m13,
+        lhs.m13 * rhs.m1 + lhs.m14 * rhs.m5 + lhs.m15 * rhs.m9  + lhs.m16 * rhs.m13,
+        lhs.m1 * rhs.m2 + lhs.m2 * rhs.m6 + lhs.m3 * rhs.m10 + lhs.m4 * rhs.m14,
+        lhs.m5 * rhs.m2 + lhs.m6 * rhs.m6 + lhs.m7 * rhs.m10 + lhs.m8 * rhs.m14,
+        lhs.m9 * rhs.m2 + lhs.m10 * rhs.m6 + lhs.m11 * rhs.m10 + lhs.m12 * rhs.m14,
+        lhs.m13 * rhs.m2 + lhs.m14 * rhs.m6 + lhs.m15 * rhs.m10 + lhs.m16 * rhs.m14,
+        lhs.m1 * rhs.m3 + lhs.m2 * rhs.m7 + lhs.m3 * rhs.m11 + lhs.m4 * rhs.m15,
+        lhs.m5 * rhs.m3 + lhs.m6 * rhs.m7 + lhs.m7 * rhs.m11 + lhs.m8 * rhs.m15,
+        lhs.m9 * rhs.m3 + lhs.m10 * rhs.m7 + lhs.m11 * rhs.m11 + lhs.m12 * rhs.m15,
+        lhs.m13 * rhs.m3 + lhs.m14 * rhs.m7 + lhs.m15 * rhs.m11 + lhs.m16 * rhs.m15,
+        lhs.m1 * rhs.m4 + lhs.m2 * rhs.m8 + lhs.m3 * rhs.m12 + lhs.m4 * rhs.m16,
+        lhs.m5 * rhs.m4 + lhs.m6 * rhs.m8 + lhs.m7 * rhs.m12 + lhs.m8 * rhs.m16,
+        lhs.m9 * rhs.m4 + lhs.m10 * rhs.m8 + lhs.m11 * rhs.m12 + lhs.m12 * rhs.m16,
+        lhs.m13 * rhs.m4 + lhs.m14 * rhs.m8 + lhs.m15 * rhs.m12 + lhs.m16 * rhs.m16
+    };
+}
+
+MyTransform my_transform_translate(MyTransform transform, MyVector translation)
+{
+    transform.m4 += translation.x;
+    transform.m8 += translation.y;
+    transform.m12 += translation.z;
+    return transform;
+}
+
+MyTransform my_transform_scale(MyTransform transform, MyVector scale)
+{
+    transform.m1 *= scale.x;
+    transform.m6 *= scale.y;
+    transform.m11 *= scale.z;
+    return transform;
+}
+
+MyTransform my_transform_rotate(MyTransform transform, MyVector rotation)
+{
+    if (rotation.x)
+    {
+        const float angleRadians = rotation.x * MY_FLOAT_RADIANS;
+        const float cosRadians = cosf(angleRadians);
+        const float sinRadians = sinf(angleRadians);
+        const MyTransform pitchTransform =
+        {
+            1.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, cosRadians, -sinRadians, 0.0f,
+            0.0f, sinRadians, cosRadians, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f
+        };
+        transform = my_transform_multiply(transform, pitchTransform);
+    }
+    if (rotation.y)
+    {
+        const float angleRadians = rotation.y * MY_FLOAT_RADIANS;
+        const float cosRadians = cosf(angleRadians);
+        const float sinRadians = sinf(angleRadians);
+        const MyTransform pitchTransform =
+        {
+            cosRadians, 0.0f, -sinRadians, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f,
+            sinRadians, 0.0f, 0.0f, cosRadians,
+            0.0f, 0.0f, 0.0f, 1.0f
+        };
+        transform = my_transform_multiply(transform, pitchTransform);
+    }
+    if (rotation.z)
+    {
+        const float angleRadians = rotation.z * MY_FLOAT_RADIANS;
+        const float cosRadians = cosf(angleRadians);
+        const float sinRadians = sinf(angleRadians);
+        const MyTransform pitchTransform =
+        {
+            cosRadians, -sinRadians, 0.0f, 0.0f,
+            sinRadians, cosRadians, 0.0f, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f
+        };
+        transform = my_transform_multiply(transform, pitchTransform);
+    }
+    return transform;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// File Functions
+////////////////////////////////////////////////////////////////////////////////
+
+char* my_file_read(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file)
+    {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    const long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* result = malloc((length + 1) * sizeof(char));
+    if (!result)
+    {
+        return NULL;
+    }
+    fread(result, length, 1, file);
+    fclose(file);
+    result[length] = '\0';
+    return result;
+}
+
+char* my_file_extension(const char* path)
+{
+    return strrchr(path, '.');
+}
+
+static bool my_file_map(const char* path, MyMapping* mapping)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || !size.QuadPart)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE view = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!view)
+    {
+        return false;
+    }
+    void* data = MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(view);
+    if (!data)
+    {
+        return false;
+    }
+    mapping->size = (size_t) size.QuadPart;
+#else
+    const int file = open(path, O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+    struct stat status;
+    if (fstat(file, &status) || !status.st_size)
+    {
+        close(file);
+        return false;
+    }
+    void* data = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+    mapping->size = (size_t) status.st_size;
+#endif
+    mapping->data = data;
+    return true;
+}
+
+static void my_file_unmap(MyMapping* mapping)
+{
+#ifdef _WIN32
+    UnmapViewOfFile(mapping->data);
+#else
+    munmap(mapping->data, mapping->size);
+#endif
+    *mapping = (MyMapping) { 0 };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Batch Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static MyHandle my_batch_create(MyHandle entityHandle)
+{
+    MyHandle batchHandle = MY_INVALID_HANDLE;
+    for (int i = 1; i < myEngine.batchCapacity; i++)
+    {
+        if (!myEngine.batches[i].batchHandle)
+        {
+            batchHandle = i;
+            break;
+        }
+    }
+    if (!batchHandle)
+    {
+        MyBatch* batches = realloc(myEngine.batches, (myEngine.batchCapacity + MY_ALLOCATOR_BATCH) * sizeof(MyBatch));
+        if (!batches)
+        {
+            return MY_INVALID_HANDLE;
+        }
+        memset(batches + myEngine.batchCapacity, 0, MY_ALLOCATOR_BATCH * sizeof(MyBatch));
+        batchHandle = myEngine.batchCapacity;
+        myEngine.batches = batches;
+        myEngine.batchCapacity += MY_ALLOCATOR_BATCH;
+    }
+    const MyEntityType entityType = myEngine.entities[entityHandle].type;
+    myEngine.batches[batchHandle].entityType = entityType;
+    myEngine.batches[batchHandle].transparent = myEngine.textures[myEngine.entities[entityHandle].textureHandle].transparent;
+    myEngine.batches[batchHandle].stationary = myEngine.entities[entityHandle].stationary && !myEngine.batches[batchHandle].transparent;
+    myEngine.batches[batchHandle].sortMode = myEngine.entities[entityHandle].sortMode;
+    myEngine.batches[batchHandle].layerHandle = myEngine.entities[entityHandle].layerHandle;
+    myEngine.batches[batchHandle].instanceSize = myEngine.pools[entityType].instanceSize;
+    myEngine.batches[batchHandle].indexSize = myEngine.entities[entityHandle].indexSize;
+    if (!my_batch_allocate(batchHandle, MY_ALLOCATOR_BATCH_ENTITY))
+    {
+        my_batch_destroy(batchHandle);
+        return MY_INVALID_HANDLE;
+    }
+    myEngine.batches[batchHandle].batchHandle = batchHandle;
+    myEngine.batches[batchHandle].bucketHandle = myEngine.textures[myEngine.entities[entityHandle].textureHandle].bucketHandle;
+    myEngine.batches[batchHandle].shaderHandle = myEngine.entities[entityHandle].shaderHandle;
+    if (!my_batch_insert(batchHandle))
+    {
+        myEngine.batches[batchHandle].batchHandle = MY_INVALID_HANDLE;
+        my_batch_destroy(batchHandle);
+        return MY_INVALID_HANDLE;
+    }
+    return batchHandle;
+}
+
+static void my_batch_destroy(MyHandle batchHandle)
+{
+    for (int i = 0; i < myEngine.batches[batchHandle].entityCount; i++)
+    {
+        const MyHandle entityHandle = myEngine.batches[batchHandle].entityHandles[i];
+        myEngine.entities[entityHandle].batchHandle = MY_INVALID_HANDLE;
+        myEngine.entities[entityHandle].entityIndex = 0;
+    }
+    if (myEngine.batches[batchHandle].batchHandle)
+    {
+        my_batch_erase(batchHandle);
+    }
+    if (myEngine.batches[batchHandle].instanceBuffer)
+    {
+        my_state_forget_buffer(myEngine.batches[batchHandle].instanceBuffer);
+        glDeleteBuffers(1, &myEngine.batches[batchHandle].instanceBuffer);
+    }
+    my_pool_release(batchHandle);
+    if (myEngine.batches[batchHandle].instances)
+    {
+        free(myEngine.batches[batchHandle].instances);
+    }
+    if (myEngine.batches[batchHandle].entityHandles)
+    {
+        free(myEngine.batches[batchHandle].entityHandles);
+    }
+    if (myEngine.batches[batchHandle].entityOrder)
+    {
+        free(myEngine.batches[batchHandle].entityOrder);
+    }
+    if (myEngine.batches[batchHandle].entityKeys)
+    {
+        free(myEngine.batches[batchHandle].entityKeys);
+    }
+    if (myEngine.batches[batchHandle].boundsX)
+    {
+        free(myEngine.batches[batchHandle].boundsX);
+    }
+    if (myEngine.batches[batchHandle].boundsY)
+    {
+        free(myEngine.batches[batchHandle].boundsY);
+    }
+    if (myEngine.batches[batchHandle].boundsZ)
+    {
+        free(myEngine.batches[batchHandle].boundsZ);
+    }
+    if (myEngine.batches[batchHandle].boundsRadius)
+    {
+        free(myEngine.batches[batchHandle].boundsRadius);
+    }
+    if (myEngine.batches[batchHandle].entityVisible)
+    {
+        free(myEngine.batches[batchHandle].entityVisible);
+    }
+    myEngine.batches[batchHandle] = (MyBatch) { 0 };
+}
+
+static bool my_batch_allocate(MyHandle batchHandle, int entityCapacity)
+{
+    const int instanceSize = myEngine.batches[batchHandle].instanceSize;
+    unsigned char* instances = realloc(myEngine.batches[batchHandle].instances, entityCapacity * instanceSize);
+    if (!instances)
+    {
+        return false;
+    }
+    myEngine.batches[batchHandle].instances = instances;
+    MyHandle* entityHandles = realloc(myEngine.batches[batchHandle].entityHandles, entityCapacity * sizeof(MyHandle));
+    if (!entityHandles)
+    {
+        return false;
+    }
+    myEngine.batches[batchHandle].entityHandles = entityHandles;
+    if (myEngine.batches[batchHandle].transparent || myEngine.batches[batchHandle].sortMode)
+    {
+        int* entityOrder = realloc(myEngine.batches[batchHandle].entityOrder, entityCapacity * sizeof(int));
+        if (!entityOrder)
+        {
+            return false;
+        }
+        myEngine.batches[batchHandle].entityOrder = entityOrder;
+    }
+    if (myEngine.batches[batchHandle].sortMode)
+    {
+        GLuint64* entityKeys = realloc(myEngine.batches[batchHandle].entityKeys, entityCapacity * sizeof(GLuint64));
+        if (!entityKeys)
+        {
+            return false;
+        }
+        myEngine.batches[batchHandle].entityKeys = entityKeys;
+    }
+    float* boundsX = realloc(myEngine.batches[batchHandle].boundsX, entityCapacity * sizeof(float));
+    if (!boundsX)
+    {
+        return false;
+    }
+    myEngine.batches[batchHandle].boundsX = boundsX;
+    float* boundsY = realloc(myEngine.batches[batchHandle].boundsY, entityCapacity * sizeof(float));
+    if (!boundsY)
+    {
+        return false;
+    }
+    myEngine.batches[batchHandle].boundsY = boundsY;
+    float* boundsZ = realloc(myEngine.batches[batchHandle].boundsZ, entityCapacity * sizeof(float));
+    if (!boundsZ)
+    {
+        return false;
+    }
+    myEngine.batches[batchHandle].boundsZ = boundsZ;
+    float* boundsRadius = realloc(myEngine.batches[batchHandle].boundsRadius, entityCapacity * sizeof(float));
+    if (!boundsRadius)
+    {
+        return false;
+    }
+    myEngine.batches[batchHandle].boundsRadius = boundsRadius;
+    bool* entityVisible = realloc(myEngine.batches[batchHandle].entityVisible, entityCapacity * sizeof(bool));
+    if (!entityVisible)
+    {
+        return false;
+    }
+    myEngine.batches[batchHandle].entityVisible = entityVisible;
+    if (!my_pool_allocate(batchHandle, entityCapacity))
+    {
+        return false;
+    }
+    for (int i = 0; i < MY_CAPACITY_RING; i++)
+    {
+        myEngine.batches[batchHandle].ringFirst[i] = INT_MAX;
+        myEngine.batches[batchHandle].ringLast[i] = -1;
+    }
+    my_batch_touch(batchHandle, 0, myEngine.batches[batchHandle].entityCount - 1);
+    return true;
+}
+
+static void my_batch_store(MyHandle entityHandle)
+{
+    const MyHandle batchHandle = myEngine.entities[entityHandle].batchHandle;
+    const int entityIndex = myEngine.entities[entityHandle].entityIndex;
+    unsigned char* instance = myEngine.batches[batchHandle].instances + entityIndex * myEngine.batches[batchHandle].instanceSize;
+    if (myEngine.batches[batchHandle].entityType == MY_ENTITY_TYPE_SPRITE)
+    {
+        const MySpriteInstance spriteInstance =
+        {
+            myEngine.entities[entityHandle].position.x,
+            myEngine.entities[entityHandle].position.y,
+            myEngine.entities[entityHandle].position.z,
+            myEngine.entities[entityHandle].rotation.z * MY_FLOAT_RADIANS,
+            myEngine.entities[entityHandle].width * myEngine.entities[entityHandle].scale.x,
+            myEngine.entities[entityHandle].height * myEngine.entities[entityHandle].scale.y,
+            my_texture_slot(myEngine.entities[entityHandle].textureHandle, myEngine.entities[entityHandle].frameIndex)
+        };
+        memcpy(instance, &spriteInstance, sizeof(MySpriteInstance));
+        myEngine.batches[batchHandle].boundsX[entityIndex] = spriteInstance.x;
+        myEngine.batches[batchHandle].boundsY[entityIndex] = spriteInstance.y;
+        myEngine.batches[batchHandle].boundsZ[entityIndex] = spriteInstance.z;
+        myEngine.batches[batchHandle].boundsRadius[entityIndex] = 0.5f * sqrtf(spriteInstance.width * spriteInstance.width + spriteInstance.height * spriteInstance.height);
+    }
+    else if (myEngine.batches[batchHandle].entityType == MY_ENTITY_TYPE_MESH)
+    {
+        const MyTransform transform = myEngine.entities[entityHandle].transform;
+        const MyVector center = myEngine.entities[entityHandle].boundsCenter;
+        const float scaleX = transform.m1 * transform.m1 + transform.m5 * transform.m5 + transform.m9 * transform.m9;
+        const float scaleY = transform.m2 * transform.m2 + transform.m6 * transform.m6 + transform.m10 * transform.m10;
+        const float scaleZ = transform.m3 * transform.m3 + transform.m7 * transform.m7 + transform.m11 * transform.m11;
+        const float scale = sqrtf(fmaxf(scaleX, fmaxf(scaleY, scaleZ)));
+        const MyMeshInstance meshInstance =
+        {
+            transform,
+            myEngine.textures[myEngine.entities[entityHandle].textureHandle].layerIndex,
+            transform.m1 * center.x + transform.m2 * center.y + transform.m3 * center.z + transform.m4,
+            transform.m5 * center.x + transform.m6 * center.y + transform.m7 * center.z + transform.m8,
+            transform.m9 * center.x + transform.m10 * center.y + transform.m11 * center.z + transform.m12,
+            myEngine.entities[entityHandle].boundsRadius * scale
+        };
+        memcpy(instance, &meshInstance, sizeof(MyMeshInstance));
+        myEngine.batches[batchHandle].boundsX[entityIndex] = meshInstance.boundsX;
+        myEngine.batches[batchHandle].boundsY[entityIndex] = meshInstance.boundsY;
+        myEngine.batches[batchHandle].boundsZ[entityIndex] = meshInstance.boundsZ;
+        myEngine.batches[batchHandle].boundsRadius[entityIndex] = meshInstance.boundsRadius;
+    }
+    if (myEngine.batches[batchHandle].sortMode == MY_SORT_MODE_Y)
+    {
+        myEngine.batches[batchHandle].entityKeys[entityIndex] = ~my_batch_bits(myEngine.batches[batchHandle].boundsY[entityIndex]);
+    }
+    else if (myEngine.batches[batchHandle].sortMode == MY_SORT_MODE_LAYER_Y)
+    {
+        myEngine.batches[batchHandle].entityKeys[entityIndex] = (GLuint64) ((GLuint) myEngine.entities[entityHandle].sortLayer ^ 0x80000000u) << 32 | ~my_batch_bits(myEngine.batches[batchHandle].boundsY[entityIndex]);
+    }
+    else if (myEngine.batches[batchHandle].sortMode == MY_SORT_MODE_KEY)
+    {
+        myEngine.batches[batchHandle].entityKeys[entityIndex] = my_batch_bits(myEngine.entities[entityHandle].sortKey);
+    }
+    my_batch_touch(batchHandle, entityIndex, entityIndex);
 }
 
-MyVector my_camera_get_position(MyHandle cameraHandle)
+static void my_batch_touch(MyHandle batchHandle, int firstIndex, int lastIndex)
 {
-    return myEngine.cameras[cameraHandle].position;
+    if (firstIndex > lastIndex)
+    {
+        return;
+    }
+    myEngine.batches[batchHandle].sorted = false;
+    myEngine.batches[batchHandle].baked = false;
+    if (myEngine.batches[batchHandle].layerHandle)
+    {
+        myEngine.layers[myEngine.batches[batchHandle].layerHandle].dirty = true;
+    }
+    for (int i = 0; i < MY_CAPACITY_RING; i++)
+    {
+        if (firstIndex < myEngine.batches[batchHandle].ringFirst[i])
+        {
+            myEngine.batches[batchHandle].ringFirst[i] = firstIndex;
+        }
+        if (lastIndex > myEngine.batches[batchHandle].ringLast[i])
+        {
+            myEngine.batches[batchHandle].ringLast[i] = lastIndex;
+        }
+    }
 }
 
-MyVector my_camera_get_rotation(MyHandle cameraHandle)
+static unsigned int my_batch_hash(MyHandle shaderHandle, MyHandle bucketHandle, MyEntityType entityType, int indexSize, bool transparent, bool stationary, MySortMode sortMode, MyHandle layerHandle)
 {
-    return myEngine.cameras[cameraHandle].rotation;
+    return (unsigned int) shaderHandle * 73856093u ^ (unsigned int) bucketHandle * 19349663u ^ (unsigned int) entityType * 83492791u ^ (unsigned int) indexSize * 40503u ^ (unsigned int) transparent * 2654435761u ^ (unsigned int) stationary * 2246822519u ^ (unsigned int) sortMode * 3266489917u ^ (unsigned int) layerHandle * 1181783497u;
 }
 
-static void my_camera_update(MyHandle cameraHandle)
+static bool my_batch_insert(MyHandle batchHandle)
 {
-    const MyVector translation =
-    {
-        -my_vector_dot(myEngine.cameras[cameraHandle].position, myEngine.cameras[cameraHandle].basisX),
-        -my_vector_dot(myEngine.cameras[cameraHandle].position, myEngine.cameras[cameraHandle].basisY),
-        -my_vector_dot(myEngine.cameras[cameraHandle].position, myEngine.cameras[cameraHandle].basisZ)
-    };
-    myEngine.cameras[cameraHandle].viewTransform = (MyTransform)
-    {
-        myEngine.cameras[cameraHandle].basisX.x, myEngine.cameras[cameraHandle].basisY.x, myEngine.cameras[cameraHandle].basisZ.x, 0.0f,
-        myEngine.cameras[cameraHandle].basisX.y, myEngine.cameras[cameraHandle].basisY.y, myEngine.cameras[cameraHandle].basisZ.y, 0.0f,
-        myEngine.cameras[cameraHandle].basisX.z, myEngine.cameras[cameraHandle].basisY.z, myEngine.cameras[cameraHandle].basisZ.z, 0.0f,
-        translation.x, translation.y, translation.z, 1.0f
-    };
-    if (myEngine.cameras[cameraHandle].projection == MY_PROJECTION_ORTHOGRAPHIC)
+    if ((myEngine.batchCount + 1) * 2 > myEngine.batchTableCapacity)
     {
-        const float scaleX = 2.0f / (myEngine.cameras[cameraHandle].right - myEngine.cameras[cameraHandle].left);
-        const float scaleY = 2.0f / (myEngine.cameras[cameraHandle].top - myEngine.cameras[cameraHandle].bottom);
-        const float scaleZ = 2.0f / (myEngine.cameras[cameraHandle].near - myEngine.cameras[cameraHandle].far);
-        myEngine.cameras[cameraHandle].projectionTransform = (MyTransform)
+        const int batchTableCapacity = myEngine.batchTableCapacity * 2;
+        MyHandle* batchTable = calloc(batchTableCapacity, sizeof(MyHandle));
+        if (!batchTable)
         {
-            scaleX, 0.0f, 0.0f, 0.0f,
-            0.0f, scaleY, 0.0f, 0.0f,
-            0.0f, 0.0f, scaleZ, 0.0f,
-            0.0f, 0.0f, 0.0f, 1.0f
-        };
-    }
-    else if (myEngine.cameras[cameraHandle].projection == MY_PROJECTION_PERSPECTIVE)
-    {
-        const float fieldOfViewRadians = myEngine.cameras[cameraHandle].fieldOfView * MY_FLOAT_RADIANS;
-        const float scaleX = 1.0f / (myEngine.cameras[cameraHandle].aspectRatio * tanf(fieldOfViewRadians * 0.5f));
-        const float scaleY = 1.0f / tanf(fieldOfViewRadians * 0.5f);
-        const float scaleZ = -myEngine.cameras[cameraHandle].far / (myEngine.cameras[cameraHandle].far - myEngine.cameras[cameraHandle].near);
-        const float translateZ = myEngine.cameras[cameraHandle].far * myEngine.cameras[cameraHandle].near / (myEngine.cameras[cameraHandle].near - myEngine.cameras[cameraHandle].far);
-        myEngine.cameras[cameraHandle].projectionTransform = (MyTransform)
+            return false;
+        }
+        for (int i = 0; i < myEngine.batchTableCapacity; i++)
         {
-            scaleX, 0.0f, 0.0f, 0.0f,
-            0.0f, scaleY, 0.0f, 0.0f,
-            0.0f, 0.0f, scaleZ, 1.0f,
-            0.0f, 0.0f, translateZ, 0.0f
-        };
+            const MyHandle tableHandle = myEngine.batchTable[i];
+            if (tableHandle)
+            {
+                unsigned int slot = my_batch_hash(myEngine.batches[tableHandle].shaderHandle, myEngine.batches[tableHandle].bucketHandle, myEngine.batches[tableHandle].entityType, myEngine.batches[tableHandle].indexSize, myEngine.batches[tableHandle].transparent, myEngine.batches[tableHandle].stationary, myEngine.batches[tableHandle].sortMode, myEngine.batches[tableHandle].layerHandle) & (batchTableCapacity - 1);
+                while (batchTable[slot])
+                {
+                    slot = (slot + 1) & (batchTableCapacity - 1);
+                }
+                batchTable[slot] = tableHandle;
+            }
+        }
+        free(myEngine.batchTable);
+        myEngine.batchTable = batchTable;
+        myEngine.batchTableCapacity = batchTableCapacity;
     }
-    if (cameraHandle == myEngine.cameraHandle)
+    const unsigned int mask = myEngine.batchTableCapacity - 1;
+    unsigned int slot = my_batch_hash(myEngine.batches[batchHandle].shaderHandle, myEngine.batches[batchHandle].bucketHandle, myEngine.batches[batchHandle].entityType, myEngine.batches[batchHandle].indexSize, myEngine.batches[batchHandle].transparent, myEngine.batches[batchHandle].stationary, myEngine.batches[batchHandle].sortMode, myEngine.batches[batchHandle].layerHandle) & mask;
+    while (myEngine.batchTable[slot])
     {
-        glNamedBufferSubData(myEngine.cameraBuffer, 0, MY_CAPACITY_CAMERA, &myEngine.cameras[cameraHandle].viewTransform);
+        slot = (slot + 1) & mask;
     }
-    myEngine.cameras[cameraHandle].dirty = false;
+    myEngine.batchTable[slot] = batchHandle;
+    myEngine.batchCount++;
+    return true;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// Clock Functions
-////////////////////////////////////////////////////////////////////////////////
-
-MyHandle my_clock_create(void)
+static void my_batch_erase(MyHandle batchHandle)
 {
-    MyHandle clockHandle = MY_INVALID_HANDLE;
-    for (int i = 1; i < myEngine.clockCapacity; i++)
+    const unsigned int mask = myEngine.batchTableCapacity - 1;
+    unsigned int slot = my_batch_hash(myEngine.batches[batchHandle].shaderHandle, myEngine.batches[batchHandle].bucketHandle, myEngine.batches[batchHandle].entityType, myEngine.batches[batchHandle].indexSize, myEngine.batches[batchHandle].transparent, myEngine.batches[batchHandle].stationary, myEngine.batches[batchHandle].sortMode, myEngine.batches[batchHandle].layerHandle) & mask;
+    while (myEngine.batchTable[slot] != batchHandle)
     {
-        if (!myEngine.clocks[i].clockHandle)
+        slot = (slot + 1) & mask;
+    }
+    unsigned int nextSlot = slot;
+    while (true)
+    {
+        nextSlot = (nextSlot + 1) & mask;
+        const MyHandle nextHandle = myEngine.batchTable[nextSlot];
+        if (!nextHandle)
         {
-            clockHandle = i;
             break;
         }
+        const unsigned int homeSlot = my_batch_hash(myEngine.batches[nextHandle].shaderHandle, myEngine.batches[nextHandle].bucketHandle, myEngine.batches[nextHandle].entityType, myEngine.batches[nextHandle].indexSize, myEngine.batches[nextHandle].transparent, myEngine.batches[nextHandle].stationary, myEngine.batches[nextHandle].sortMode, myEngine.batches[nextHandle].layerHandle) & mask;
+        if (((nextSlot - homeSlot) & mask) >= ((nextSlot - slot) & mask))
+        {
+            myEngine.batchTable[slot] = nextHandle;
+            slot = nextSlot;
+        }
     }
-    if (!clockHandle)
-    {
-        MyClock* clocks = realloc(myEngine.clocks, (myEngine.clockCapacity + MY_ALLOCATOR_CLOCK) * sizeof(MyClock));
-        if (!clocks)
+    myEngine.batchTable[slot] = MY_INVALID_HANDLE;
+    myEngine.batchCount--;
+}
+
+static MyHandle my_batch_match(MyHandle entityHandle)
+{
+    const MyHandle shaderHandle = myEngine.entities[entityHandle].shaderHandle;
+    const MyHandle bucketHandle = myEngine.textures[myEngine.entities[entityHandle].textureHandle].bucketHandle;
+    const MyEntityType entityType = myEngine.entities[entityHandle].type;
+    const int indexSize = myEngine.entities[entityHandle].indexSize;
+    const bool transparent = myEngine.textures[myEngine.entities[entityHandle].textureHandle].transparent;
+    const bool stationary = myEngine.entities[entityHandle].stationary && !transparent;
+    const MySortMode sortMode = myEngine.entities[entityHandle].sortMode;
+    const MyHandle layerHandle = myEngine.entities[entityHandle].layerHandle;
+    const unsigned int mask = myEngine.batchTableCapacity - 1;
+    unsigned int slot = my_batch_hash(shaderHandle, bucketHandle, entityType, indexSize, transparent, stationary, sortMode, layerHandle) & mask;
+    while (myEngine.batchTable[slot])
+    {
+        const MyHandle batchHandle = myEngine.batchTable[slot];
+        if (myEngine.batches[batchHandle].shaderHandle == shaderHandle &&
+            myEngine.batches[batchHandle].bucketHandle == bucketHandle &&
+            myEngine.batches[batchHandle].entityType == entityType &&
+            myEngine.batches[batchHandle].indexSize == indexSize &&
+            myEngine.batches[batchHandle].transparent == transparent &&
+            myEngine.batches[batchHandle].stationary == stationary &&
+            myEngine.batches[batchHandle].sortMode == sortMode &&
+            myEngine.batches[batchHandle].layerHandle == layerHandle)
         {
-            return MY_INVALID_HANDLE;
+            return batchHandle;
         }
-        clockHandle = myEngine.clockCapacity;
-        myEngine.clocks = clocks;
-        myEngine.clockCapacity += MY_ALLOCATOR_CLOCK;
+        slot = (slot + 1) & mask;
     }
-    myEngine.clocks[clockHandle].clockHandle = clockHandle;
-    return clockHandle;
+    return MY_INVALID_HANDLE;
 }
 
-void my_clock_destroy(MyHandle clockHandle)
+static bool my_batch_reserve(MyHandle batchHandle, int entityCount)
 {
-    myEngine.clocks[clockHandle] = (MyClock) { 0 };
+    if (entityCount > myEngine.batches[batchHandle].entityCapacity)
+    {
+        int entityCapacity = myEngine.batches[batchHandle].entityCapacity;
+        while (entityCapacity < entityCount)
+        {
+            entityCapacity *= 2;
+        }
+        if (!my_batch_allocate(batchHandle, entityCapacity))
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
-void my_clock_start(MyHandle clockHandle)
+static GLuint my_batch_resize(GLuint buffer, int size, int capacity)
 {
-    myEngine.clocks[clockHandle].lastTime = (float) glfwGetTime();
-    myEngine.clocks[clockHandle].active = true;
+    GLuint resizedBuffer = 0;
+    glCreateBuffers(1, &resizedBuffer);
+    if (!resizedBuffer)
+    {
+        return 0;
+    }
+    glNamedBufferStorage(resizedBuffer, capacity, NULL, GL_DYNAMIC_STORAGE_BIT);
+    if (size)
+    {
+        glCopyNamedBufferSubData(buffer, resizedBuffer, 0, 0, size);
+    }
+    my_state_forget_buffer(buffer);
+    glDeleteBuffers(1, &buffer);
+    return resizedBuffer;
 }
 
-void my_clock_stop(MyHandle clockHandle)
+static bool my_batch_add(MyHandle entityHandle)
 {
-    myEngine.clocks[clockHandle].active = false;
+    MyHandle batchHandle = my_batch_match(entityHandle);
+    if (!batchHandle)
+    {
+        batchHandle = my_batch_create(entityHandle);
+        if (!batchHandle)
+        {
+            return false;
+        }
+    }
+    if (!my_batch_reserve(batchHandle, myEngine.batches[batchHandle].entityCount + 1))
+    {
+        return false;
+    }
+    myEngine.batches[batchHandle].entityHandles[myEngine.batches[batchHandle].entityCount] = entityHandle;
+    if (myEngine.batches[batchHandle].sortMode)
+    {
+        myEngine.batches[batchHandle].entityOrder[myEngine.batches[batchHandle].entityCount] = myEngine.batches[batchHandle].entityCount;
+    }
+    myEngine.entities[entityHandle].batchHandle = batchHandle;
+    myEngine.entities[entityHandle].entityIndex = myEngine.batches[batchHandle].entityCount;
+    my_batch_store(entityHandle);
+    myEngine.batches[batchHandle].entityCount++;
+    return true;
 }
 
-void my_clock_reset(MyHandle clockHandle)
+static void my_batch_remove(MyHandle entityHandle)
 {
-    myEngine.clocks[clockHandle].lastTime = (float) glfwGetTime();
-    myEngine.clocks[clockHandle].totalTime = 0.0f;
-    myEngine.clocks[clockHandle].intervalTime = 0.0f;
+    const MyHandle batchHandle = myEngine.entities[entityHandle].batchHandle;
+    const int entityIndex = myEngine.entities[entityHandle].entityIndex;
+    const int lastIndex = myEngine.batches[batchHandle].entityCount - 1;
+    const int instanceSize = myEngine.batches[batchHandle].instanceSize;
+    if (myEngine.batches[batchHandle].sortMode)
+    {
+        int* entityOrder = myEngine.batches[batchHandle].entityOrder;
+        int orderCount = 0;
+        for (int i = 0; i <= lastIndex; i++)
+        {
+            if (entityOrder[i] != entityIndex)
+            {
+                entityOrder[orderCount] = entityOrder[i] == lastIndex ? entityIndex : entityOrder[i];
+                orderCount++;
+            }
+        }
+        myEngine.batches[batchHandle].entityKeys[entityIndex] = myEngine.batches[batchHandle].entityKeys[lastIndex];
+    }
+    if (entityIndex != lastIndex)
+    {
+        const MyHandle lastHandle = myEngine.batches[batchHandle].entityHandles[lastIndex];
+        memcpy(myEngine.batches[batchHandle].instances + entityIndex * instanceSize, myEngine.batches[batchHandle].instances + lastIndex * instanceSize, instanceSize);
+        myEngine.batches[batchHandle].boundsX[entityIndex] = myEngine.batches[batchHandle].boundsX[lastIndex];
+        myEngine.batches[batchHandle].boundsY[entityIndex] = myEngine.batches[batchHandle].boundsY[lastIndex];
+        myEngine.batches[batchHandle].boundsZ[entityIndex] = myEngine.batches[batchHandle].boundsZ[lastIndex];
+        myEngine.batches[batchHandle].boundsRadius[entityIndex] = myEngine.batches[batchHandle].boundsRadius[lastIndex];
+        myEngine.batches[batchHandle].entityHandles[entityIndex] = lastHandle;
+        myEngine.entities[lastHandle].entityIndex = entityIndex;
+        my_batch_touch(batchHandle, entityIndex, entityIndex);
+    }
+    myEngine.batches[batchHandle].sorted = false;
+    if (myEngine.batches[batchHandle].layerHandle)
+    {
+        myEngine.layers[myEngine.batches[batchHandle].layerHandle].dirty = true;
+    }
+    myEngine.entities[entityHandle].batchHandle = MY_INVALID_HANDLE;
+    myEngine.entities[entityHandle].entityIndex = 0;
+    myEngine.batches[batchHandle].entityCount--;
+    if (!myEngine.batches[batchHandle].entityCount)
+    {
+        my_batch_destroy(batchHandle);
+    }
 }
 
-void my_clock_set_interval(MyHandle clockHandle, float interval)
+static float my_batch_depth(MyHandle batchHandle, int entityIndex)
 {
-    myEngine.clocks[clockHandle].interval = interval;
-    myEngine.clocks[clockHandle].intervalTime = 0.0f;
+    const unsigned char* instance = myEngine.batches[batchHandle].instances + entityIndex * myEngine.batches[batchHandle].instanceSize;
+    MyVector position = MY_VECTOR_ZERO;
+    if (myEngine.batches[batchHandle].entityType == MY_ENTITY_TYPE_SPRITE)
+    {
+        const MySpriteInstance* spriteInstance = (const MySpriteInstance*) instance;
+        position = (MyVector) { spriteInstance->x, spriteInstance->y, spriteInstance->z };
+    }
+    else if (myEngine.batches[batchHandle].entityType == MY_ENTITY_TYPE_MESH)
+    {
+        const MyMeshInstance* meshInstance = (const MyMeshInstance*) instance;
+        position = (MyVector) { meshInstance->transform.m4, meshInstance->transform.m8, meshInstance->transform.m12 };
+    }
+    const MyHandle layerHandle = myEngine.batches[batchHandle].layerHandle;
+    const MyHandle cameraHandle = layerHandle && myEngine.layers[layerHandle].cameraHandle ? myEngine.layers[layerHandle].cameraHandle : myEngine.cameraHandle;
+    const MyVector distance = my_vector_subtract(position, myEngine.cameras[cameraHandle].position);
+    return my_vector_dot(distance, myEngine.cameras[cameraHandle].basisZ);
 }
 
-void my_clock_set_callback(MyHandle clockHandle, MyClockCallback callback)
+static GLuint64 my_batch_key(MyHandle batchHandle)
 {
-    myEngine.clocks[clockHandle].callback = callback;
+    GLuint depthBits = 0;
+    memcpy(&depthBits, &myEngine.batches[batchHandle].depth, sizeof(GLuint));
+    const GLuint64 depthKey = depthBits & 0x80000000u ? ~depthBits : depthBits | 0x80000000u;
+    const GLuint64 stateKey = (GLuint64) (myEngine.batches[batchHandle].shaderHandle & 0x7FFF) << 16 |
+        (GLuint64) (myEngine.batches[batchHandle].bucketHandle & 0xFFFF);
+    if (myEngine.batches[batchHandle].transparent)
+    {
+        return (GLuint64) 3 << 62 | (~depthKey & 0xFFFFFFFFu) >> 1 << 31 | stateKey;
+    }
+    if (myEngine.batches[batchHandle].sortMode)
+    {
+        return (GLuint64) 2 << 62 | (GLuint64) myEngine.batches[batchHandle].entityType << 31 | stateKey;
+    }
+    return ((GLuint64) myEngine.batches[batchHandle].entityType << 31 | stateKey) << 31 | depthKey >> 1;
 }
 
-float my_clock_get_time(MyHandle clockHandle)
+static GLuint my_batch_bits(float value)
 {
-    return myEngine.clocks[clockHandle].totalTime;
+    GLuint bits = 0;
+    memcpy(&bits, &value, sizeof(GLuint));
+    return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
 }
 
-float my_clock_get_progress(MyHandle clockHandle)
+static bool my_batch_order(MyHandle batchHandle)
 {
-    return myEngine.clocks[clockHandle].intervalTime / myEngine.clocks[clockHandle].interval;
+    const int entityCount = myEngine.batches[batchHandle].entityCount;
+    const bool transparent = myEngine.batches[batchHandle].transparent;
+    if (transparent && !my_batch_scratch(myEngine.batchCount + entityCount))
+    {
+        return false;
+    }
+    MySortItem* items = myEngine.sortItems + myEngine.batchCount;
+    float nearDepth = FLT_MAX;
+    float farDepth = -FLT_MAX;
+    for (int i = 0; i < entityCount; i++)
+    {
+        const float depth = my_batch_depth(batchHandle, i);
+        nearDepth = depth < nearDepth ? depth : nearDepth;
+        farDepth = depth > farDepth ? depth : farDepth;
+        if (transparent)
+        {
+            GLuint depthBits = 0;
+            memcpy(&depthBits, &depth, sizeof(GLuint));
+            items[i] = (MySortItem) { ~(depthBits & 0x80000000u ? ~depthBits : depthBits | 0x80000000u), i };
+        }
+    }
+    if (myEngine.batches[batchHandle].sortMode)
+    {
+        int* entityOrder = myEngine.batches[batchHandle].entityOrder;
+        const GLuint64* entityKeys = myEngine.batches[batchHandle].entityKeys;
+        for (int i = 1; i < entityCount; i++)
+        {
+            const int entityIndex = entityOrder[i];
+            int j = i;
+            for (; j > 0 && entityKeys[entityOrder[j - 1]] > entityKeys[entityIndex]; j--)
+            {
+                entityOrder[j] = entityOrder[j - 1];
+            }
+            entityOrder[j] = entityIndex;
+        }
+    }
+    else if (transparent)
+    {
+        my_batch_sort(items, entityCount);
+        for (int i = 0; i < entityCount; i++)
+        {
+            myEngine.batches[batchHandle].entityOrder[i] = items[i].value;
+        }
+    }
+    myEngine.batches[batchHandle].depth = transparent ? farDepth : nearDepth;
+    myEngine.batches[batchHandle].sorted = true;
+    return true;
 }
 
-static void my_clock_frame_callback(MyHandle clockHandle)
+static bool my_batch_scratch(int count)
 {
-    myEngine.frameRate = myEngine.frameCount;
-    myEngine.frameCount = 0;
+    if (count <= myEngine.sortCapacity)
+    {
+        return true;
+    }
+    int sortCapacity = myEngine.sortCapacity ? myEngine.sortCapacity : MY_ALLOCATOR_SORT;
+    while (sortCapacity < count)
+    {
+        sortCapacity *= 2;
+    }
+    MySortItem* sortItems = realloc(myEngine.sortItems, sortCapacity * sizeof(MySortItem));
+    if (!sortItems)
+    {
+        return false;
+    }
+    myEngine.sortItems = sortItems;
+    MySortItem* sortScratch = realloc(myEngine.sortScratch, sortCapacity * sizeof(MySortItem));
+    if (!sortScratch)
+    {
+        return false;
+    }
+    myEngine.sortScratch = sortScratch;
+    myEngine.sortCapacity = sortCapacity;
+    return true;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// Float Functions
-////////////////////////////////////////////////////////////////////////////////
+static void my_batch_sort(MySortItem* items, int count)
+{
+    MySortItem* sourceItems = items;
+    MySortItem* targetItems = myEngine.sortScratch + (items - myEngine.sortItems);
+    for (int shift = 0; shift < 64 && count > 1; shift += 8)
+    {
+        int offsets[256] = { 0 };
+        for (int i = 0; i < count; i++)
+        {
+            offsets[(sourceItems[i].key >> shift) & 0xFF]++;
+        }
+        if (offsets[(sourceItems[0].key >> shift) & 0xFF] == count)
+        {
+            continue;
+        }
+        int offset = 0;
+        for (int i = 0; i < 256; i++)
+        {
+            const int bucketCount = offsets[i];
+            offsets[i] = offset;
+            offset += bucketCount;
+        }
+        for (int i = 0; i < count; i++)
+        {
+            targetItems[offsets[(sourceItems[i].key >> shift) & 0xFF]++] = sourceItems[i];
+        }
+        MySortItem* swapItems = sourceItems;
+        sourceItems = targetItems;
+        targetItems = swapItems;
+    }
+    if (sourceItems != items)
+    {
+        memcpy(items, sourceItems, count * sizeof(MySortItem));
+    }
+}
 
-float my_float_randomize(float floor, float ceiling)
+static void my_batch_clip(MyHandle batchHandle)
 {
-    const float range = ceiling - floor;
-    return (float) rand() / RAND_MAX * range + floor;
+    const MyCamera* camera = &myEngine.cameras[myEngine.cameraHandle];
+    const int entityCount = myEngine.batches[batchHandle].entityCount;
+    const float* boundsX = myEngine.batches[batchHandle].boundsX;
+    const float* boundsY = myEngine.batches[batchHandle].boundsY;
+    const float* boundsZ = myEngine.batches[batchHandle].boundsZ;
+    const float* boundsRadius = myEngine.batches[batchHandle].boundsRadius;
+    bool* entityVisible = myEngine.batches[batchHandle].entityVisible;
+    int entityIndex = 0;
+#ifdef MY_SIMD_SSE
+    for (; entityIndex + 4 <= entityCount; entityIndex += 4)
+    {
+        const __m128 x = _mm_loadu_ps(boundsX + entityIndex);
+        const __m128 y = _mm_loadu_ps(boundsY + entityIndex);
+        const __m128 z = _mm_loadu_ps(boundsZ + entityIndex);
+        const __m128 radius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(boundsRadius + entityIndex));
+        __m128 outside = _mm_setzero_ps();
+        for (int i = 0; i < camera->planeCount; i++)
+        {
+            __m128 distance = _mm_set1_ps(camera->planes[i].distance);
+            distance = _mm_add_ps(distance, _mm_mul_ps(x, _mm_set1_ps(camera->planes[i].normal.x)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(camera->planes[i].normal.y)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(camera->planes[i].normal.z)));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, radius));
+        }
+        const int outsideMask = _mm_movemask_ps(outside);
+        for (int i = 0; i < 4; i++)
+        {
+            entityVisible[entityIndex + i] = !(outsideMask & (1 << i));
+        }
+    }
+#endif
+    for (; entityIndex < entityCount; entityIndex++)
+    {
+        const MyVector center = { boundsX[entityIndex], boundsY[entityIndex], boundsZ[entityIndex] };
+        entityVisible[entityIndex] = true;
+        for (int i = 0; i < camera->planeCount; i++)
+        {
+            if (my_vector_dot(camera->planes[i].normal, center) + camera->planes[i].distance < -boundsRadius[entityIndex])
+            {
+                entityVisible[entityIndex] = false;
+                break;
+            }
+        }
+    }
 }
 
-float my_float_clamp(float value, float floor, float ceiling)
+static void my_batch_upload(MyHandle batchHandle)
 {
-    if (value < floor)
+    const MyEntityType entityType = myEngine.batches[batchHandle].entityType;
+    const int entityCount = myEngine.batches[batchHandle].entityCount;
+    const int instanceSize = myEngine.batches[batchHandle].instanceSize;
+    const int instanceBase = myEngine.batches[batchHandle].instanceBase;
+    const int drawBase = myEngine.batches[batchHandle].stationary ? 0 : instanceBase;
+    const int ringOffset = myEngine.ringIndex * myEngine.pools[entityType].instanceCapacity;
+    const int ringFirst = myEngine.batches[batchHandle].ringFirst[myEngine.ringIndex];
+    const int ringLast = myEngine.batches[batchHandle].ringLast[myEngine.ringIndex];
+    const bool transparent = myEngine.batches[batchHandle].transparent;
+    unsigned char* instanceRing = myEngine.pools[entityType].instanceRing + (ringOffset + instanceBase) * instanceSize;
+    MyIndirect* indirectRing = myEngine.pools[entityType].indirectRing + ringOffset + myEngine.pools[entityType].drawCount;
+    const bool stationary = myEngine.batches[batchHandle].stationary;
+    const bool ordered = transparent || myEngine.batches[batchHandle].sortMode;
+    const bool culling = myEngine.culling && !myEngine.batches[batchHandle].layerHandle && entityType != MY_ENTITY_TYPE_MESH;
+    int drawCount = 0;
+    if (stationary && !myEngine.batches[batchHandle].baked && !my_batch_bake(batchHandle))
+    {
+        myEngine.batches[batchHandle].drawCount = 0;
+        return;
+    }
+    if (entityType == MY_ENTITY_TYPE_SPRITE && myEngine.batches[batchHandle].sortMode)
     {
-        return floor;
+        if (!stationary && ringFirst <= ringLast)
+        {
+            memcpy(instanceRing + ringFirst * instanceSize, myEngine.batches[batchHandle].instances + ringFirst * instanceSize, (ringLast - ringFirst + 1) * instanceSize);
+        }
+        for (int i = 0; i < entityCount; i++)
+        {
+            const int entityIndex = myEngine.batches[batchHandle].entityOrder[i];
+            if (culling && !myEngine.batches[batchHandle].entityVisible[entityIndex])
+            {
+                continue;
+            }
+            indirectRing[drawCount] = (MyIndirect) { sizeof(myQuadIndices) / sizeof(GLushort), 1, 0, 0, drawBase + entityIndex };
+            drawCount++;
+        }
+    }
+    else if (entityType == MY_ENTITY_TYPE_SPRITE)
+    {
+        int instanceCount = entityCount;
+        if (!stationary && (culling || transparent))
+        {
+            instanceCount = 0;
+            for (int i = 0; i < entityCount; i++)
+            {
+                const int entityIndex = transparent ? myEngine.batches[batchHandle].entityOrder[i] : i;
+                if (culling && !myEngine.batches[batchHandle].entityVisible[entityIndex])
+                {
+                    continue;
+                }
+                memcpy(instanceRing + instanceCount * instanceSize, myEngine.batches[batchHandle].instances + entityIndex * instanceSize, instanceSize);
+                instanceCount++;
+            }
+        }
+        else if (!stationary && ringFirst <= ringLast)
+        {
+            memcpy(instanceRing + ringFirst * instanceSize, myEngine.batches[batchHandle].instances + ringFirst * instanceSize, (ringLast - ringFirst + 1) * instanceSize);
+        }
+        if (instanceCount)
+        {
+            indirectRing[drawCount] = (MyIndirect) { sizeof(myQuadIndices) / sizeof(GLushort), instanceCount, 0, 0, drawBase };
+            drawCount++;
+        }
     }
-    if (value > ceiling)
+    else if (entityType == MY_ENTITY_TYPE_MESH)
     {
-        return ceiling;
+        if (!stationary && ringFirst <= ringLast)
+        {
+            memcpy(instanceRing + ringFirst * instanceSize, myEngine.batches[batchHandle].instances + ringFirst * instanceSize, (ringLast - ringFirst + 1) * instanceSize);
+        }
+        const int vertexSize = myEngine.pools[entityType].vertexSize;
+        for (int i = 0; i < entityCount; i++)
+        {
+            const int entityIndex = ordered ? myEngine.batches[batchHandle].entityOrder[i] : i;
+            if (culling && !myEngine.batches[batchHandle].entityVisible[entityIndex])
+            {
+                continue;
+            }
+            const MyGeometry* geometry = &myEngine.geometries[myEngine.entities[myEngine.batches[batchHandle].entityHandles[entityIndex]].geometryHandle];
+            indirectRing[drawCount] = (MyIndirect) { geometry->indexCount, 1, geometry->indexBase / geometry->indexSize, geometry->vertexBase / vertexSize, drawBase + entityIndex };
+            drawCount++;
+        }
     }
-    return value;
+    myEngine.batches[batchHandle].drawFirst = myEngine.pools[entityType].drawCount;
+    myEngine.batches[batchHandle].drawCount = drawCount;
+    myEngine.batches[batchHandle].ringFirst[myEngine.ringIndex] = INT_MAX;
+    myEngine.batches[batchHandle].ringLast[myEngine.ringIndex] = -1;
+    myEngine.pools[entityType].drawCount += drawCount;
 }
 
-float my_float_wrap(float value, float floor, float ceiling)
+static bool my_batch_bake(MyHandle batchHandle)
 {
-    const float range = ceiling - floor;
-    while (value < floor)
+    GLuint instanceBuffer = 0;
+    glCreateBuffers(1, &instanceBuffer);
+    if (!instanceBuffer)
     {
-        value += range;
+        return false;
     }
-    while (value > ceiling)
+    glNamedBufferStorage(instanceBuffer, myEngine.batches[batchHandle].entityCount * myEngine.batches[batchHandle].instanceSize, myEngine.batches[batchHandle].instances, 0);
+    if (myEngine.batches[batchHandle].instanceBuffer)
     {
-        value -= range;
+        my_state_forget_buffer(myEngine.batches[batchHandle].instanceBuffer);
+        glDeleteBuffers(1, &myEngine.batches[batchHandle].instanceBuffer);
     }
-    return value;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-// Color Functions
-////////////////////////////////////////////////////////////////////////////////
-
-MyColor my_color_uniform(float value, bool alpha)
-{
-    return (MyColor)
-    {
-        value,
-        value,
-        value,
-        alpha ? value : 1.0f
-    };
+    myEngine.batches[batchHandle].instanceBuffer = instanceBuffer;
+    myEngine.batches[batchHandle].baked = true;
+    return true;
 }
 
-MyColor my_color_randomize(bool alpha)
+static bool my_batch_compatible(MyHandle batchHandle, MyHandle otherHandle)
 {
-    return (MyColor)
-    {
-        (float) rand() / RAND_MAX,
-        (float) rand() / RAND_MAX,
-        (float) rand() / RAND_MAX,
-        alpha ? (float) rand() / RAND_MAX : 1.0f
-    };
+    return myEngine.batches[batchHandle].entityType == myEngine.batches[otherHandle].entityType &&
+        myEngine.batches[batchHandle].shaderHandle == myEngine.batches[otherHandle].shaderHandle &&
+        (myEngine.bindless || myEngine.batches[batchHandle].bucketHandle == myEngine.batches[otherHandle].bucketHandle) &&
+        myEngine.batches[batchHandle].indexSize == myEngine.batches[otherHandle].indexSize &&
+        myEngine.batches[batchHandle].transparent == myEngine.batches[otherHandle].transparent &&
+        myEngine.batches[batchHandle].sortMode == myEngine.batches[otherHandle].sortMode &&
+        !myEngine.batches[batchHandle].stationary &&
+        !myEngine.batches[otherHandle].stationary &&
+        myEngine.batches[batchHandle].layerHandle == myEngine.batches[otherHandle].layerHandle;
 }
 
-MyColor my_color_clamp(MyColor color)
+static void my_batch_draw(int batchCount, MyHandle layerHandle)
 {
-    return (MyColor)
+    bool blending = false;
+    for (int j = 0; j < batchCount;)
+    {
+        const MyHandle i = myEngine.sortItems[j].value;
+        const MyEntityType entityType = myEngine.batches[i].entityType;
+        const MyHandle shaderHandle = myEngine.batches[i].shaderHandle;
+        const MyHandle bucketHandle = myEngine.batches[i].bucketHandle;
+        const int drawFirst = myEngine.batches[i].drawFirst;
+        int drawCount = myEngine.batches[i].drawCount;
+        for (j++; j < batchCount && my_batch_compatible(i, myEngine.sortItems[j].value); j++)
+        {
+            drawCount += myEngine.batches[myEngine.sortItems[j].value].drawCount;
+        }
+        if (myEngine.batches[i].layerHandle != layerHandle || !drawCount)
+        {
+            continue;
+        }
+        if (myEngine.batches[i].transparent && !blending)
+        {
+            my_state_set_blend(true);
+            my_state_set_depth_mask(false);
+            blending = true;
+        }
+        else if (!blending)
+        {
+            my_state_set_depth_mask(!myEngine.batches[i].sortMode);
+        }
+        const int instanceSize = myEngine.pools[entityType].instanceSize;
+        const int ringOffset = myEngine.ringIndex * myEngine.pools[entityType].instanceCapacity;
+        const GLuint instanceBuffer = myEngine.batches[i].stationary ? myEngine.batches[i].instanceBuffer : myEngine.pools[entityType].instanceBuffer;
+        const int instanceOffset = myEngine.batches[i].stationary ? 0 : ringOffset;
+        const GLenum indexType = myEngine.batches[i].indexSize == sizeof(GLuint) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+        if (entityType == MY_ENTITY_TYPE_MESH && myEngine.culling)
+        {
+            my_pool_cull(entityType, instanceBuffer, instanceOffset, ringOffset + drawFirst, drawCount);
+        }
+        my_state_bind_vertex_format(myEngine.pools[entityType].vertexFormat);
+        my_state_bind_vertex_buffer(entityType, MY_BUFFER_ENTITY_VERTEX, myEngine.pools[entityType].vertexBuffer, 0, myEngine.pools[entityType].vertexSize);
+        my_state_bind_vertex_buffer(entityType, MY_BUFFER_ENTITY_INSTANCE, instanceBuffer, instanceOffset * instanceSize, instanceSize);
+        my_state_bind_element_buffer(entityType, myEngine.pools[entityType].indexBuffer);
+        my_state_use_program(myEngine.shaders[shaderHandle].program);
+        if (!myEngine.bindless)
+        {
+            my_state_bind_texture(MY_SAMPLER_ENTITY, myEngine.buckets[bucketHandle].texture);
+        }
+        my_state_bind_indirect_buffer(myEngine.pools[entityType].indirectBuffer);
+        glMultiDrawElementsIndirect(GL_TRIANGLES, indexType, (const void*) ((ringOffset + drawFirst) * sizeof(MyIndirect)), drawCount, 0);
+    }
+    if (blending)
     {
-        my_float_clamp(color.red, 0.0f, 1.0f),
-        my_float_clamp(color.green, 0.0f, 1.0f),
-        my_float_clamp(color.blue, 0.0f, 1.0f),
-        my_float_clamp(color.alpha, 0.0f, 1.0f)
-    };
+        my_state_set_blend(false);
+    }
+    my_state_set_depth_mask(true);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// Vector Functions
+// Bucket Functions
 ////////////////////////////////////////////////////////////////////////////////
 
-MyVector my_vector_uniform(float value)
+static MyHandle my_bucket_create(int width, int height)
 {
-    return (MyVector)
+    MyHandle bucketHandle = MY_INVALID_HANDLE;
+    for (int i = 1; i < myEngine.bucketCapacity; i++)
     {
-        value,
-        value,
-        value
-    };
-}
-
-MyVector my_vector_randomize(MyVector floor, MyVector ceiling)
-{
-    return (MyVector)
+        if (!myEngine.buckets[i].bucketHandle)
+        {
+            bucketHandle = i;
+            break;
+        }
+    }
+    if (!bucketHandle)
     {
-        my_float_randomize(floor.x, ceiling.x),
-        my_float_randomize(floor.y, ceiling.y),
-        my_float_randomize(floor.z, ceiling.z)
-    };
+        MyBucket* buckets = realloc(myEngine.buckets, (myEngine.bucketCapacity + MY_ALLOCATOR_BUCKET) * sizeof(MyBucket));
+        if (!buckets)
+        {
+            return MY_INVALID_HANDLE;
+        }
+        memset(buckets + myEngine.bucketCapacity, 0, MY_ALLOCATOR_BUCKET * sizeof(MyBucket));
+        bucketHandle = myEngine.bucketCapacity;
+        myEngine.buckets = buckets;
+        myEngine.bucketCapacity += MY_ALLOCATOR_BUCKET;
+    }
+    myEngine.buckets[bucketHandle].width = width;
+    myEngine.buckets[bucketHandle].height = height;
+    if (!my_bucket_allocate(bucketHandle, MY_ALLOCATOR_BUCKET_LAYER))
+    {
+        my_bucket_destroy(bucketHandle);
+        return MY_INVALID_HANDLE;
+    }
+    myEngine.buckets[bucketHandle].bucketHandle = bucketHandle;
+    return bucketHandle;
 }
 
-MyVector my_vector_add(MyVector lhs, MyVector rhs)
+static void my_bucket_destroy(MyHandle bucketHandle)
 {
-    return (MyVector)
+    if (myEngine.buckets[bucketHandle].texture)
     {
-        lhs.x + rhs.x,
-        lhs.y + rhs.y,
-        lhs.z + rhs.z
-    };
+        my_state_forget_texture(myEngine.buckets[bucketHandle].texture);
+        glDeleteTextures(1, &myEngine.buckets[bucketHandle].texture);
+    }
+    if (myEngine.buckets[bucketHandle].layerTextures)
+    {
+        free(myEngine.buckets[bucketHandle].layerTextures);
+    }
+    myEngine.buckets[bucketHandle] = (MyBucket) { 0 };
 }
 
-MyVector my_vector_subtract(MyVector lhs, MyVector rhs)
+static bool my_bucket_allocate(MyHandle bucketHandle, int layerCapacity)
 {
-    return (MyVector)
+    if (layerCapacity > myEngine.layerLimit)
     {
-        lhs.x - rhs.x,
-        lhs.y - rhs.y,
-        lhs.z - rhs.z
-    };
+        layerCapacity = myEngine.layerLimit;
+    }
+    if (layerCapacity <= myEngine.buckets[bucketHandle].layerCapacity)
+    {
+        return false;
+    }
+    MyHandle* layerTextures = realloc(myEngine.buckets[bucketHandle].layerTextures, layerCapacity * sizeof(MyHandle));
+    if (!layerTextures)
+    {
+        return false;
+    }
+    memset(layerTextures + myEngine.buckets[bucketHandle].layerCapacity, 0, (layerCapacity - myEngine.buckets[bucketHandle].layerCapacity) * sizeof(MyHandle));
+    myEngine.buckets[bucketHandle].layerTextures = layerTextures;
+    GLuint texture = 0;
+    glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &texture);
+    if (!texture)
+    {
+        return false;
+    }
+    glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTextureStorage3D(texture, 1, GL_RGBA8, myEngine.buckets[bucketHandle].width, myEngine.buckets[bucketHandle].height, layerCapacity);
+    if (myEngine.buckets[bucketHandle].texture)
+    {
+        glCopyImageSubData(myEngine.buckets[bucketHandle].texture, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, texture, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, myEngine.buckets[bucketHandle].width, myEngine.buckets[bucketHandle].height, myEngine.buckets[bucketHandle].layerCapacity);
+        my_state_forget_texture(myEngine.buckets[bucketHandle].texture);
+        glDeleteTextures(1, &myEngine.buckets[bucketHandle].texture);
+    }
+    myEngine.buckets[bucketHandle].texture = texture;
+    myEngine.buckets[bucketHandle].layerCapacity = layerCapacity;
+    return true;
 }
 
-MyVector my_vector_scale(MyVector vector, MyVector scale)
+static MyHandle my_bucket_match(int width, int height)
 {
-    return (MyVector)
+    for (int i = 1; i < myEngine.bucketCapacity; i++)
     {
-        vector.x * scale.x,
-        vector.y * scale.y,
-        vector.z * scale.z
-    };
+        if (myEngine.buckets[i].bucketHandle &&
+            myEngine.buckets[i].width == width &&
+            myEngine.buckets[i].height == height &&
+            myEngine.buckets[i].layerCount < myEngine.layerLimit)
+        {
+            return i;
+        }
+    }
+    return MY_INVALID_HANDLE;
 }
 
-MyVector my_vector_negate(MyVector vector)
+static bool my_bucket_add(MyHandle textureHandle)
 {
-    return (MyVector)
+    int width = 1;
+    int height = 1;
+    while (width < myEngine.textures[textureHandle].width)
     {
-        -vector.x,
-        -vector.y,
-        -vector.z,
-    };
+        width *= 2;
+    }
+    while (height < myEngine.textures[textureHandle].height)
+    {
+        height *= 2;
+    }
+    MyHandle bucketHandle = my_bucket_match(width, height);
+    if (!bucketHandle)
+    {
+        bucketHandle = my_bucket_create(width, height);
+        if (!bucketHandle)
+        {
+            return false;
+        }
+    }
+    int layerIndex = myEngine.buckets[bucketHandle].layerCapacity;
+    for (int i = 0; i < myEngine.buckets[bucketHandle].layerCapacity; i++)
+    {
+        if (!myEngine.buckets[bucketHandle].layerTextures[i])
+        {
+            layerIndex = i;
+            break;
+        }
+    }
+    if (layerIndex == myEngine.buckets[bucketHandle].layerCapacity && !my_bucket_allocate(bucketHandle, layerIndex * 2))
+    {
+        if (!myEngine.buckets[bucketHandle].layerCount)
+        {
+            my_bucket_destroy(bucketHandle);
+        }
+        return false;
+    }
+    glTextureSubImage3D(myEngine.buckets[bucketHandle].texture, 0, 0, 0, layerIndex, myEngine.textures[textureHandle].width, myEngine.textures[textureHandle].height, 1, GL_RGBA, GL_UNSIGNED_BYTE, myEngine.textures[textureHandle].pixels);
+    myEngine.buckets[bucketHandle].layerTextures[layerIndex] = textureHandle;
+    myEngine.buckets[bucketHandle].layerCount++;
+    myEngine.textures[textureHandle].bucketHandle = bucketHandle;
+    myEngine.textures[textureHandle].layerIndex = layerIndex;
+    return true;
 }
 
-float my_vector_length(MyVector vector)
+static void my_bucket_remove(MyHandle textureHandle)
 {
-    return sqrtf(vector.x * vector.x + vector.y * vector.y + vector.z * vector.z);
+    const MyHandle bucketHandle = myEngine.textures[textureHandle].bucketHandle;
+    myEngine.buckets[bucketHandle].layerTextures[myEngine.textures[textureHandle].layerIndex] = MY_INVALID_HANDLE;
+    myEngine.buckets[bucketHandle].layerCount--;
+    myEngine.textures[textureHandle].bucketHandle = MY_INVALID_HANDLE;
+    myEngine.textures[textureHandle].layerIndex = 0;
+    if (!myEngine.buckets[bucketHandle].layerCount)
+    {
+        my_bucket_destroy(bucketHandle);
+    }
 }
 
-MyVector my_vector_normalize(MyVector vector)
+////////////////////////////////////////////////////////////////////////////////
+// Pool Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static bool my_pool_create(MyEntityType entityType)
 {
-    const float length = my_vector_length(vector);
-    if (length == 0.0f)
+    glCreateVertexArrays(1, &myEngine.pools[entityType].vertexFormat);
+    if (!myEngine.pools[entityType].vertexFormat)
     {
-        return MY_VECTOR_ZERO;
+        return false;
     }
-    return my_vector_scale(vector, my_vector_uniform(1.0f / length));
-}
-
-float my_vector_dot(MyVector lhs, MyVector rhs)
-{
-    return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z;
+    const GLuint vertexFormat = myEngine.pools[entityType].vertexFormat;
+    if (entityType == MY_ENTITY_TYPE_SPRITE)
+    {
+        glCreateBuffers(1, &myEngine.pools[entityType].vertexBuffer);
+        if (!myEngine.pools[entityType].vertexBuffer)
+        {
+            return false;
+        }
+        glCreateBuffers(1, &myEngine.pools[entityType].indexBuffer);
+        if (!myEngine.pools[entityType].indexBuffer)
+        {
+            return false;
+        }
+        glNamedBufferStorage(myEngine.pools[entityType].vertexBuffer, sizeof(myQuadVertices), myQuadVertices, 0);
+        glNamedBufferStorage(myEngine.pools[entityType].indexBuffer, sizeof(myQuadIndices), myQuadIndices, 0);
+        myEngine.pools[entityType].instanceSize = sizeof(MySpriteInstance);
+        myEngine.pools[entityType].vertexSize = sizeof(GLfloat) * 5;
+        myEngine.pools[entityType].vertexCapacity = sizeof(myQuadVertices);
+        myEngine.pools[entityType].vertexOffset = sizeof(myQuadVertices);
+        myEngine.pools[entityType].indexCapacity = sizeof(myQuadIndices);
+        myEngine.pools[entityType].indexOffset = sizeof(myQuadIndices);
+        glVertexArrayAttribBinding(vertexFormat, MY_ATTRIBUTE_SPRITE_POSITION, MY_BUFFER_ENTITY_VERTEX);
+        glVertexArrayAttribBinding(vertexFormat, MY_ATTRIBUTE_SPRITE_TEXTURE, MY_BUFFER_ENTITY_VERTEX);
+        glVertexArrayAttribBinding(vertexFormat, MY_ATTRIBUTE_SPRITE_ORIGIN, MY_BUFFER_ENTITY_INSTANCE);
+        glVertexArrayAttribBinding(vertexFormat, MY_ATTRIBUTE_SPRITE_SIZE, MY_BUFFER_ENTITY_INSTANCE);
+        glVertexArrayAttribBinding(vertexFormat, MY_ATTRIBUTE_SPRITE_FRAME, MY_BUFFER_ENTITY_INSTANCE);
+        glVertexArrayAttribFormat(vertexFormat, MY_ATTRIBUTE_SPRITE_POSITION, 3, GL_FLOAT, GL_FALSE, 0);
+        glVertexArrayAttribFormat(vertexFormat, MY_ATTRIBUTE_SPRITE_TEXTURE, 2, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 3);
+        glVertexArrayAttribFormat(vertexFormat, MY_ATTRIBUTE_SPRITE_ORIGIN, 4, GL_FLOAT, GL_FALSE, 0);
+        glVertexArrayAttribFormat(vertexFormat, MY_ATTRIBUTE_SPRITE_SIZE, 2, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 4);
+        glVertexArrayAttribIFormat(vertexFormat, MY_ATTRIBUTE_SPRITE_FRAME, 1, GL_UNSIGNED_INT, sizeof(GLfloat) * 6);
+        glEnableVertexArrayAttrib(vertexFormat, MY_ATTRIBUTE_SPRITE_POSITION);
+        glEnableVertexArrayAttrib(vertexFormat, MY_ATTRIBUTE_SPRITE_TEXTURE);
+        glEnableVertexArrayAttrib(vertexFormat, MY_ATTRIBUTE_SPRITE_ORIGIN);
+        glEnableVertexArrayAttrib(vertexFormat, MY_ATTRIBUTE_SPRITE_SIZE);
+        glEnableVertexArrayAttrib(vertexFormat, MY_ATTRIBUTE_SPRITE_FRAME);
+    }
+    else if (entityType == MY_ENTITY_TYPE_MESH)
+    {
+        myEngine.pools[entityType].instanceSize = sizeof(MyMeshInstance);
+        myEngine.pools[entityType].vertexSize = sizeof(GLfloat) * 8;
+        glVertexArrayAttribBinding(vertexFormat, MY_ATTRIBUTE_MESH_POSITION, MY_BUFFER_ENTITY_VERTEX);
+        glVertexArrayAttribBinding(vertexFormat, MY_ATTRIBUTE_MESH_TEXTURE, MY_BUFFER_ENTITY_VERTEX);
+        glVertexArrayAttribBinding(vertexFormat, MY_ATTRIBUTE_MESH_NORMAL, MY_BUFFER_ENTITY_VERTEX);
+        glVertexArrayAttribBinding(vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_X, MY_BUFFER_ENTITY_INSTANCE);
+        glVertexArrayAttribBinding(vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_Y, MY_BUFFER_ENTITY_INSTANCE);
+        glVertexArrayAttribBinding(vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_Z, MY_BUFFER_ENTITY_INSTANCE);
+        glVertexArrayAttribBinding(vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_W, MY_BUFFER_ENTITY_INSTANCE);
+        glVertexArrayAttribBinding(vertexFormat, MY_ATTRIBUTE_MESH_LAYER, MY_BUFFER_ENTITY_INSTANCE);
+        glVertexArrayAttribFormat(vertexFormat, MY_ATTRIBUTE_MESH_POSITION, 3, GL_FLOAT, GL_FALSE, 0);
+        glVertexArrayAttribFormat(vertexFormat, MY_ATTRIBUTE_MESH_TEXTURE, 2, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 3);
+        glVertexArrayAttribFormat(vertexFormat, MY_ATTRIBUTE_MESH_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 5);
+        glVertexArrayAttribFormat(vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_X, 4, GL_FLOAT, GL_FALSE, 0);
+        glVertexArrayAttribFormat(vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_Y, 4, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 4);
+        glVertexArrayAttribFormat(vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_Z, 4, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 8);
+        glVertexArrayAttribFormat(vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_W, 4, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 12);
+        glVertexArrayAttribIFormat(vertexFormat, MY_ATTRIBUTE_MESH_LAYER, 1, GL_UNSIGNED_INT, sizeof(GLfloat) * 16);
+        glEnableVertexArrayAttrib(vertexFormat, MY_ATTRIBUTE_MESH_POSITION);
+        glEnableVertexArrayAttrib(vertexFormat, MY_ATTRIBUTE_MESH_TEXTURE);
+        glEnableVertexArrayAttrib(vertexFormat, MY_ATTRIBUTE_MESH_NORMAL);
+        glEnableVertexArrayAttrib(vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_X);
+        glEnableVertexArrayAttrib(vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_Y);
+        glEnableVertexArrayAttrib(vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_Z);
+        glEnableVertexArrayAttrib(vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_W);
+        glEnableVertexArrayAttrib(vertexFormat, MY_ATTRIBUTE_MESH_LAYER);
+    }
+    else if (entityType == MY_ENTITY_TYPE_VOXEL)
+    {
+        myEngine.pools[entityType].vertexSize = sizeof(GLuint);
+        glVertexArrayAttribBinding(vertexFormat, MY_ATTRIBUTE_VOXEL_VERTEX, MY_BUFFER_ENTITY_VERTEX);
+        glVertexArrayAttribIFormat(vertexFormat, MY_ATTRIBUTE_VOXEL_VERTEX, 1, GL_UNSIGNED_INT, 0);
+        glEnableVertexArrayAttrib(vertexFormat, MY_ATTRIBUTE_VOXEL_VERTEX);
+    }
+    glVertexArrayBindingDivisor(vertexFormat, MY_BUFFER_ENTITY_INSTANCE, 1);
+    return true;
 }
 
-MyVector my_vector_cross(MyVector lhs, MyVector rhs)
+static void my_pool_destroy(MyEntityType entityType)
 {
-    return (MyVector)
+    if (myEngine.pools[entityType].vertexFormat)
     {
-        lhs.y * rhs.z - lhs.z * rhs.y,
-        lhs.z * rhs.x - lhs.x * rhs.z,
-        lhs.x * rhs.y - lhs.y * rhs.x
-    };
+        my_state_forget_vertex_format(myEngine.pools[entityType].vertexFormat);
+        glDeleteVertexArrays(1, &myEngine.pools[entityType].vertexFormat);
+    }
+    if (myEngine.pools[entityType].vertexBuffer)
+    {
+        my_state_forget_buffer(myEngine.pools[entityType].vertexBuffer);
+        glDeleteBuffers(1, &myEngine.pools[entityType].vertexBuffer);
+    }
+    if (myEngine.pools[entityType].indexBuffer)
+    {
+        my_state_forget_buffer(myEngine.pools[entityType].indexBuffer);
+        glDeleteBuffers(1, &myEngine.pools[entityType].indexBuffer);
+    }
+    if (myEngine.pools[entityType].instanceBuffer)
+    {
+        my_state_forget_buffer(myEngine.pools[entityType].instanceBuffer);
+        glDeleteBuffers(1, &myEngine.pools[entityType].instanceBuffer);
+    }
+    if (myEngine.pools[entityType].indirectBuffer)
+    {
+        my_state_forget_buffer(myEngine.pools[entityType].indirectBuffer);
+        glDeleteBuffers(1, &myEngine.pools[entityType].indirectBuffer);
+    }
+    myEngine.pools[entityType] = (MyPool) { 0 };
 }
 
-MyVector my_vector_rotate(MyVector vector, MyVector rotation)
+static bool my_pool_allocate(MyHandle batchHandle, int entityCapacity)
 {
-    if (rotation.x)
+    const MyEntityType entityType = myEngine.batches[batchHandle].entityType;
+    const bool trailing = myEngine.batches[batchHandle].instanceBase + myEngine.batches[batchHandle].entityCapacity == myEngine.pools[entityType].instanceCount;
+    const int instanceBase = trailing ? myEngine.batches[batchHandle].instanceBase : myEngine.pools[entityType].instanceCount;
+    if (instanceBase + entityCapacity <= myEngine.pools[entityType].instanceCapacity)
+    {
+        myEngine.batches[batchHandle].instanceBase = instanceBase;
+        myEngine.batches[batchHandle].entityCapacity = entityCapacity;
+        myEngine.pools[entityType].instanceCount = instanceBase + entityCapacity;
+        my_batch_touch(batchHandle, 0, myEngine.batches[batchHandle].entityCount - 1);
+        return true;
+    }
+    int instanceCount = entityCapacity;
+    for (int i = 1; i < myEngine.batchCapacity; i++)
     {
-        const float radians = rotation.x * MY_FLOAT_RADIANS;
-        const float cosRadians = cosf(radians);
-        const float sinRadians = sinf(radians);
-        vector = (MyVector)
+        if (myEngine.batches[i].batchHandle && myEngine.batches[i].entityType == entityType && i != batchHandle)
         {
-            vector.x,
-            vector.y * cosRadians + vector.z * -sinRadians,
-            vector.y * sinRadians + vector.z * cosRadians
-        };
+            instanceCount += myEngine.batches[i].entityCapacity;
+        }
     }
-    if (rotation.y)
+    int instanceCapacity = myEngine.pools[entityType].instanceCapacity ? myEngine.pools[entityType].instanceCapacity : MY_ALLOCATOR_POOL_ENTITY;
+    while (instanceCapacity < instanceCount)
     {
-        const float radians = rotation.y * MY_FLOAT_RADIANS;
-        const float cosRadians = cosf(radians);
-        const float sinRadians = sinf(radians);
-        vector = (MyVector)
-        {
-            vector.x * cosRadians + vector.z * sinRadians,
-            vector.y,
-            vector.x * -sinRadians + vector.z * cosRadians
-        };
+        instanceCapacity *= 2;
     }
-    if (rotation.z)
+    if (instanceCapacity > myEngine.pools[entityType].instanceCapacity)
     {
-        const float radians = rotation.z * MY_FLOAT_RADIANS;
-        const float cosRadians = cosf(radians);
-        const float sinRadians = sinf(radians);
-        vector = (MyVector)
+        const int instanceSize = myEngine.pools[entityType].instanceSize;
+        GLuint instanceBuffer = 0;
+        GLuint indirectBuffer = 0;
+        glCreateBuffers(1, &instanceBuffer);
+        glCreateBuffers(1, &indirectBuffer);
+        if (!instanceBuffer || !indirectBuffer)
         {
-            vector.x * cosRadians + vector.y * -sinRadians,
-            vector.x * sinRadians + vector.y * cosRadians,
-            vector.z
-        };
+            glDeleteBuffers(1, &instanceBuffer);
+            glDeleteBuffers(1, &indirectBuffer);
+            return false;
+        }
+        glNamedBufferStorage(instanceBuffer, MY_CAPACITY_RING * instanceCapacity * instanceSize, NULL, MY_FLAGS_RING);
+        glNamedBufferStorage(indirectBuffer, MY_CAPACITY_RING * instanceCapacity * sizeof(MyIndirect), NULL, MY_FLAGS_RING);
+        unsigned char* instanceRing = glMapNamedBufferRange(instanceBuffer, 0, MY_CAPACITY_RING * instanceCapacity * instanceSize, MY_FLAGS_RING);
+        MyIndirect* indirectRing = glMapNamedBufferRange(indirectBuffer, 0, MY_CAPACITY_RING * instanceCapacity * sizeof(MyIndirect), MY_FLAGS_RING);
+        if (!instanceRing || !indirectRing)
+        {
+            glDeleteBuffers(1, &instanceBuffer);
+            glDeleteBuffers(1, &indirectBuffer);
+            return false;
+        }
+        if (myEngine.pools[entityType].instanceBuffer)
+        {
+            my_state_forget_buffer(myEngine.pools[entityType].instanceBuffer);
+            glDeleteBuffers(1, &myEngine.pools[entityType].instanceBuffer);
+        }
+        if (myEngine.pools[entityType].indirectBuffer)
+        {
+            my_state_forget_buffer(myEngine.pools[entityType].indirectBuffer);
+            glDeleteBuffers(1, &myEngine.pools[entityType].indirectBuffer);
+        }
+        myEngine.pools[entityType].instanceBuffer = instanceBuffer;
+        myEngine.pools[entityType].indirectBuffer = indirectBuffer;
+        myEngine.pools[entityType].instanceRing = instanceRing;
+        myEngine.pools[entityType].indirectRing = indirectRing;
+        myEngine.pools[entityType].instanceCapacity = instanceCapacity;
     }
-    return vector;
-}
-
-MyVector my_vector_clamp(MyVector vector, MyVector floor, MyVector ceiling)
-{
-    return (MyVector)
+    myEngine.pools[entityType].instanceCount = 0;
+    for (int i = 1; i < myEngine.batchCapacity; i++)
     {
-        my_float_clamp(vector.x, floor.x, ceiling.x),
-        my_float_clamp(vector.y, floor.y, ceiling.y),
-        my_float_clamp(vector.z, floor.z, ceiling.z)
-    };
+        if (myEngine.batches[i].batchHandle && myEngine.batches[i].entityType == entityType && i != batchHandle)
+        {
+            myEngine.batches[i].instanceBase = myEngine.pools[entityType].instanceCount;
+            myEngine.pools[entityType].instanceCount += myEngine.batches[i].entityCapacity;
+            my_batch_touch(i, 0, myEngine.batches[i].entityCount - 1);
+        }
+    }
+    myEngine.batches[batchHandle].instanceBase = myEngine.pools[entityType].instanceCount;
+    myEngine.batches[batchHandle].entityCapacity = entityCapacity;
+    myEngine.pools[entityType].instanceCount += entityCapacity;
+    my_batch_touch(batchHandle, 0, myEngine.batches[batchHandle].entityCount - 1);
+    return true;
 }
 
-MyVector my_vector_wrap(MyVector vector, MyVector floor, MyVector ceiling)
+static void my_pool_release(MyHandle batchHandle)
 {
-    return (MyVector)
+    const MyEntityType entityType = myEngine.batches[batchHandle].entityType;
+    if (myEngine.batches[batchHandle].instanceBase + myEngine.batches[batchHandle].entityCapacity == myEngine.pools[entityType].instanceCount)
     {
-        my_float_wrap(vector.x, floor.x, ceiling.x),
-        my_float_wrap(vector.y, floor.y, ceiling.y),
-        my_float_wrap(vector.z, floor.z, ceiling.z)
-    };
+        myEngine.pools[entityType].instanceCount = myEngine.batches[batchHandle].instanceBase;
+    }
 }
 
-void my_vector_basis(MyVector* basisX, MyVector* basisY, MyVector* basisZ, MyVector rotation)
+static void my_pool_cull(MyEntityType entityType, GLuint instanceBuffer, int instanceOffset, int drawOffset, int drawCount)
 {
-    *basisZ = my_vector_normalize(my_vector_rotate(MY_VECTOR_BASIS_Z, rotation));
-    *basisX = my_vector_normalize(my_vector_cross(*basisZ, MY_VECTOR_BASIS_Y));
-    *basisY = my_vector_normalize(my_vector_cross(*basisX, *basisZ));
+    my_state_use_program(myEngine.cullProgram);
+    glProgramUniform1ui(myEngine.cullProgram, MY_UNIFORM_CULL_OFFSET, drawOffset);
+    glProgramUniform1ui(myEngine.cullProgram, MY_UNIFORM_CULL_COUNT, drawCount);
+    glProgramUniform1ui(myEngine.cullProgram, MY_UNIFORM_CULL_STRIDE, myEngine.pools[entityType].instanceSize / sizeof(GLfloat));
+    glProgramUniform1ui(myEngine.cullProgram, MY_UNIFORM_CULL_BOUNDS, offsetof(MyMeshInstance, boundsX) / sizeof(GLfloat));
+    glProgramUniform1ui(myEngine.cullProgram, MY_UNIFORM_CULL_INSTANCE, instanceOffset);
+    my_state_bind_storage_buffer(MY_BUFFER_CULL_INSTANCE, instanceBuffer);
+    my_state_bind_storage_buffer(MY_BUFFER_CULL_INDIRECT, myEngine.pools[entityType].indirectBuffer);
+    glDispatchCompute((drawCount + MY_WORKGROUP_CULL - 1) / MY_WORKGROUP_CULL, 1, 1);
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// Transform Functions
+// State Functions
 ////////////////////////////////////////////////////////////////////////////////
 
-MyTransform my_transform_compose(MyVector position, MyVector scale, MyVector rotation)
+static void my_state_use_program(GLuint program)
 {
-    MyTransform transform = my_transform_scale(MY_TRANSFORM_IDENTITY, scale);
-    transform = my_transform_rotate(transform, rotation);
-    transform = my_transform_translate(transform, position);
-    return transform;
+    if (myEngine.state.program == program)
+    {
+        myEngine.state.avoidedCount++;
+        return;
+    }
+    glUseProgram(program);
+    myEngine.state.program = program;
+    myEngine.state.issuedCount++;
 }
 
-MyTransform my_transform_multiply(MyTransform lhs, MyTransform rhs)
+static void my_state_bind_vertex_format(GLuint vertexFormat)
 {
-    return (MyTransform)
+    if (myEngine.state.vertexFormat == vertexFormat)
     {
-        lhs.m1 * rhs.m1 + lhs.m2 * rhs.m5 + lhs.m3 * rhs.m9  + lhs.m4 * rhs.m13,
-        lhs.m5 * rhs.m1 + lhs.m6 * rhs.m5 + lhs.m7 * rhs.m9  + lhs.m8 * rhs.m13,
-        lhs.m9 * rhs.m1 + lhs.m10 * rhs.m5 + lhs.m11 * rhs.m9  + lhs.m12 * rhs.m13,
-        lhs.m13 * rhs.m1 + lhs.m14 * rhs.m5 + lhs.m15 * rhs.m9  + lhs.m16 * rhs.m13,
-        lhs.m1 * rhs.m2 + lhs.m2 * rhs.m6 + lhs.m3 * rhs.m10 + lhs.m4 * rhs.m14,
-        lhs.m5 * rhs.m2 + lhs.m6 * rhs.m6 + lhs.m7 * rhs.m10 + lhs.m8 * rhs.m14,
-        lhs.m9 * rhs.m2 + lhs.m10 * rhs.m6 + lhs.m11 * rhs.m10 + lhs.m12 * rhs.m14,
-        lhs.m13 * rhs.m2 + lhs.m14 * rhs.m6 + lhs.m15 * rhs.m10 + lhs.m16 * rhs.m14,
-        lhs.m1 * rhs.m3 + lhs.m2 * rhs.m7 + lhs.m3 * rhs.m11 + lhs.m4 * rhs.m15,
-        lhs.m5 * rhs.m3 + lhs.m6 * rhs.m7 + lhs.m7 * rhs.m11 + lhs.m8 * rhs.m15,
-        lhs.m9 * rhs.m3 + lhs.m10 * rhs.m7 + lhs.m11 * rhs.m11 + lhs.m12 * rhs.m15,
-        lhs.m13 * rhs.m3 + lhs.m14 * rhs.m7 + lhs.m15 * rhs.m11 + lhs.m16 * rhs.m15,
-        lhs.m1 * rhs.m4 + lhs.m2 * rhs.m8 + lhs.m3 * rhs.m12 + lhs.m4 * rhs.m16,
-        lhs.m5 * rhs.m4 + lhs.m6 * rhs.m8 + lhs.m7 * rhs.m12 + lhs.m8 * rhs.m16,
-        lhs.m9 * rhs.m4 + lhs.m10 * rhs.m8 + lhs.m11 * rhs.m12 + lhs.m12 * rhs.m16,
-        lhs.m13 * rhs.m4 + lhs.m14 * rhs.m8 + lhs.m15 * rhs.m12 + lhs.m16 * rhs.m16
-    };
+        myEngine.state.avoidedCount++;
+        return;
+    }
+    glBindVertexArray(vertexFormat);
+    myEngine.state.vertexFormat = vertexFormat;
+    myEngine.state.issuedCount++;
 }
 
-MyTransform my_transform_translate(MyTransform transform, MyVector translation)
+static void my_state_bind_vertex_buffer(MyEntityType entityType, GLuint bindingIndex, GLuint buffer, GLintptr offset, GLsizei stride)
 {
-    transform.m4 += translation.x;
-    transform.m8 += translation.y;
-    transform.m12 += translation.z;
-    return transform;
+    if (myEngine.pools[entityType].bindingBuffers[bindingIndex] == buffer && myEngine.pools[entityType].bindingOffsets[bindingIndex] == offset)
+    {
+        myEngine.state.avoidedCount++;
+        return;
+    }
+    glVertexArrayVertexBuffer(myEngine.pools[entityType].vertexFormat, bindingIndex, buffer, offset, stride);
+    myEngine.pools[entityType].bindingBuffers[bindingIndex] = buffer;
+    myEngine.pools[entityType].bindingOffsets[bindingIndex] = offset;
+    myEngine.state.issuedCount++;
 }
 
-MyTransform my_transform_scale(MyTransform transform, MyVector scale)
+static void my_state_bind_element_buffer(MyEntityType entityType, GLuint buffer)
 {
-    transform.m1 *= scale.x;
-    transform.m6 *= scale.y;
-    transform.m11 *= scale.z;
-    return transform;
+    if (myEngine.pools[entityType].elementBuffer == buffer)
+    {
+        myEngine.state.avoidedCount++;
+        return;
+    }
+    glVertexArrayElementBuffer(myEngine.pools[entityType].vertexFormat, buffer);
+    myEngine.pools[entityType].elementBuffer = buffer;
+    myEngine.state.issuedCount++;
 }
 
-MyTransform my_transform_rotate(MyTransform transform, MyVector rotation)
+static void my_state_bind_indirect_buffer(GLuint buffer)
 {
-    if (rotation.x)
-    {
-        const float angleRadians = rotation.x * MY_FLOAT_RADIANS;
-        const float cosRadians = cosf(angleRadians);
-        const float sinRadians = sinf(angleRadians);
-        const MyTransform pitchTransform =
-        {
-            1.0f, 0.0f, 0.0f, 0.0f,
-            0.0f, cosRadians, -sinRadians, 0.0f,
-            0.0f, sinRadians, cosRadians, 0.0f,
-            0.0f, 0.0f, 0.0f, 1.0f
-        };
-        transform = my_transform_multiply(transform, pitchTransform);
-    }
-    if (rotation.y)
-    {
-        const float angleRadians = rotation.y * MY_FLOAT_RADIANS;
-        const float cosRadians = cosf(angleRadians);
-        const float sinRadians = sinf(angleRadians);
-        const MyTransform pitchTransform =
-        {
-            cosRadians, 0.0f, -sinRadians, 0.0f,
-            0.0f, 0.0f, 1.0f, 0.0f,
-            sinRadians, 0.0f, 0.0f, cosRadians,
-            0.0f, 0.0f, 0.0f, 1.0f
-        };
-        transform = my_transform_multiply(transform, pitchTransform);
-    }
-    if (rotation.z)
+    if (myEngine.state.indirectBuffer == buffer)
     {
-        const float angleRadians = rotation.z * MY_FLOAT_RADIANS;
-        const float cosRadians = cosf(angleRadians);
-        const float sinRadians = sinf(angleRadians);
-        const MyTransform pitchTransform =
-        {
-            cosRadians, -sinRadians, 0.0f, 0.0f,
-            sinRadians, cosRadians, 0.0f, 0.0f,
-            0.0f, 0.0f, 1.0f, 0.0f,
-            0.0f, 0.0f, 0.0f, 1.0f
-        };
-        transform = my_transform_multiply(transform, pitchTransform);
+        myEngine.state.avoidedCount++;
+        return;
     }
-    return transform;
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer);
+    myEngine.state.indirectBuffer = buffer;
+    myEngine.state.issuedCount++;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// File Functions
-////////////////////////////////////////////////////////////////////////////////
-
-char* my_file_read(const char* path)
+static void my_state_bind_storage_buffer(GLuint bindingIndex, GLuint buffer)
 {
-    FILE* file = fopen(path, "rb");
-    if (!file)
-    {
-        return NULL;
-    }
-    fseek(file, 0, SEEK_END);
-    const long length = ftell(file);
-    fseek(file, 0, SEEK_SET);
-    char* result = malloc((length + 1) * sizeof(char));
-    if (!result)
+    if (myEngine.state.storageBuffers[bindingIndex] == buffer)
     {
-        return NULL;
+        myEngine.state.avoidedCount++;
+        return;
     }
-    fread(result, length, 1, file);
-    fclose(file);
-    result[length] = '\0';
-    return result;
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bindingIndex, buffer);
+    myEngine.state.storageBuffers[bindingIndex] = buffer;
+    myEngine.state.issuedCount++;
 }
 
-char* my_file_extension(const char* path)
+static void my_state_bind_texture(GLuint unit, GLuint texture)
 {
-    return strrchr(path, '.');
+    if (myEngine.state.textures[unit] == texture)
+    {
+        myEngine.state.avoidedCount++;
+        return;
+    }
+    glBindTextureUnit(unit, texture);
+    myEngine.state.textures[unit] = texture;
+    myEngine.state.issuedCount++;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// Batch Functions
-////////////////////////////////////////////////////////////////////////////////
-
-static MyHandle my_batch_create(MyHandle entityHandle)
+static void my_state_set_depth_test(bool depthTest)
 {
-    MyHandle batchHandle = MY_INVALID_HANDLE;
-    for (int i = 1; i < myEngine.batchCapacity; i++)
+    if (myEngine.state.depthTest == depthTest)
     {
-        if (!myEngine.batches[i].batchHandle)
-        {
-            batchHandle = i;
-            break;
-        }
-    }
-    if (!batchHandle)
-    {
-        MyBatch* batches = realloc(myEngine.batches, (myEngine.batchCapacity + MY_ALLOCATOR_BATCH) * sizeof(MyBatch));
-        if (!batches)
-        {
-            return MY_INVALID_HANDLE;
-        }
-        batchHandle = myEngine.batchCapacity;
-        myEngine.batches = batches;
-        myEngine.batchCapacity += MY_ALLOCATOR_BATCH;
+        myEngine.state.avoidedCount++;
+        return;
     }
-    glCreateVertexArrays(1, &myEngine.batches[batchHandle].vertexFormat);
-    if (!myEngine.batches[batchHandle].vertexFormat)
+    if (depthTest)
     {
-        my_batch_destroy(batchHandle);
-        return MY_INVALID_HANDLE;
+        glEnable(GL_DEPTH_TEST);
     }
-    glCreateBuffers(1, &myEngine.batches[batchHandle].vertexBuffer);
-    if (!myEngine.batches[batchHandle].vertexBuffer)
+    else
     {
-        my_batch_destroy(batchHandle);
-        return MY_INVALID_HANDLE;
+        glDisable(GL_DEPTH_TEST);
     }
-    glCreateBuffers(1, &myEngine.batches[batchHandle].indexBuffer);
-    if (!myEngine.batches[batchHandle].indexBuffer)
+    myEngine.state.depthTest = depthTest;
+    myEngine.state.issuedCount++;
+}
+
+static void my_state_set_blend(bool blend)
+{
+    if (myEngine.state.blend == blend)
     {
-        my_batch_destroy(batchHandle);
-        return MY_INVALID_HANDLE;
+        myEngine.state.avoidedCount++;
+        return;
     }
-    glCreateBuffers(1, &myEngine.batches[batchHandle].transformBuffer);
-    if (!myEngine.batches[batchHandle].transformBuffer)
+    if (blend)
     {
-        my_batch_destroy(batchHandle);
-        return MY_INVALID_HANDLE;
+        glEnable(GL_BLEND);
     }
-    glCreateBuffers(1, &myEngine.batches[batchHandle].indirectBuffer);
-    if (!myEngine.batches[batchHandle].indirectBuffer)
+    else
     {
-        my_batch_destroy(batchHandle);
-        return MY_INVALID_HANDLE;
+        glDisable(GL_BLEND);
     }
-    if (myEngine.batches[batchHandle].entityType == MY_ENTITY_TYPE_SPRITE)
+    myEngine.state.blend = blend;
+    myEngine.state.issuedCount++;
+}
+
+static void my_state_set_blend_func(GLenum blendSource, GLenum blendDestination, GLenum blendSourceAlpha, GLenum blendDestinationAlpha)
+{
+    if (myEngine.state.blendSource == blendSource && myEngine.state.blendDestination == blendDestination && myEngine.state.blendSourceAlpha == blendSourceAlpha && myEngine.state.blendDestinationAlpha == blendDestinationAlpha)
     {
-        glVertexArrayAttribBinding(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_POSITION, MY_BUFFER_ENTITY_VERTEX);
-        glVertexArrayAttribBinding(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TEXTURE, MY_BUFFER_ENTITY_VERTEX);
-        glVertexArrayAttribBinding(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TRANSFORM_X, MY_BUFFER_ENTITY_TRANSFORM);
-        glVertexArrayAttribBinding(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TRANSFORM_Y, MY_BUFFER_ENTITY_TRANSFORM);
-        glVertexArrayAttribBinding(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TRANSFORM_Z, MY_BUFFER_ENTITY_TRANSFORM);
-        glVertexArrayAttribBinding(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TRANSFORM_W, MY_BUFFER_ENTITY_TRANSFORM);
-        glVertexArrayAttribFormat(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_POSITION, 3, GL_FLOAT, GL_FALSE, 0);
-        glVertexArrayAttribFormat(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TEXTURE, 2, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 3);
-        glVertexArrayAttribFormat(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TRANSFORM_X, 4, GL_FLOAT, GL_FALSE, 0);
-        glVertexArrayAttribFormat(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TRANSFORM_Y, 4, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 4);
-        glVertexArrayAttribFormat(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TRANSFORM_Z, 4, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 8);
-        glVertexArrayAttribFormat(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TRANSFORM_W, 4, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 12);
-        glEnableVertexArrayAttrib(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_POSITION);
-        glEnableVertexArrayAttrib(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TEXTURE);
-        glEnableVertexArrayAttrib(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TRANSFORM_X);
-        glEnableVertexArrayAttrib(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TRANSFORM_Y);
-        glEnableVertexArrayAttrib(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TRANSFORM_Z);
-        glEnableVertexArrayAttrib(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_SPRITE_TRANSFORM_W);
-        glVertexArrayBindingDivisor(myEngine.batches[batchHandle].vertexFormat, MY_BUFFER_ENTITY_TRANSFORM, 1);
+        myEngine.state.avoidedCount++;
+        return;
     }
-    else if (myEngine.batches[batchHandle].entityType == MY_ENTITY_TYPE_MESH)
-    {
-        glVertexArrayAttribBinding(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_POSITION, MY_BUFFER_ENTITY_VERTEX);
-        glVertexArrayAttribBinding(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TEXTURE, MY_BUFFER_ENTITY_VERTEX);
-        glVertexArrayAttribBinding(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_NORMAL, MY_BUFFER_ENTITY_VERTEX);
-        glVertexArrayAttribBinding(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_X, MY_BUFFER_ENTITY_TRANSFORM);
-        glVertexArrayAttribBinding(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_Y, MY_BUFFER_ENTITY_TRANSFORM);
-        glVertexArrayAttribBinding(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_Z, MY_BUFFER_ENTITY_TRANSFORM);
-        glVertexArrayAttribBinding(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_W, MY_BUFFER_ENTITY_TRANSFORM);
-        glVertexArrayAttribFormat(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_POSITION, 3, GL_FLOAT, GL_FALSE, 0);
-        glVertexArrayAttribFormat(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TEXTURE, 2, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 3);
-        glVertexArrayAttribFormat(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 5);
-        glVertexArrayAttribFormat(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_X, 4, GL_FLOAT, GL_FALSE, 0);
-        glVertexArrayAttribFormat(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_Y, 4, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 4);
-        glVertexArrayAttribFormat(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_Z, 4, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 8);
-        glVertexArrayAttribFormat(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_W, 4, GL_FLOAT, GL_FALSE, sizeof(GLfloat) * 12);
-        glEnableVertexArrayAttrib(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_POSITION);
-        glEnableVertexArrayAttrib(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TEXTURE);
-        glEnableVertexArrayAttrib(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_NORMAL);
-        glEnableVertexArrayAttrib(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_X);
-        glEnableVertexArrayAttrib(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_Y);
-        glEnableVertexArrayAttrib(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_Z);
-        glEnableVertexArrayAttrib(myEngine.batches[batchHandle].vertexFormat, MY_ATTRIBUTE_MESH_TRANSFORM_W);
-        glVertexArrayBindingDivisor(myEngine.batches[batchHandle].vertexFormat, MY_BUFFER_ENTITY_TRANSFORM, 1);
-    }
-    glNamedBufferStorage(myEngine.batches[batchHandle].vertexBuffer, MY_ALLOCATOR_BATCH_VERTEX, NULL, GL_DYNAMIC_STORAGE_BIT);
-    glNamedBufferStorage(myEngine.batches[batchHandle].indexBuffer, MY_ALLOCATOR_BATCH_INDEX, NULL, GL_DYNAMIC_STORAGE_BIT);
-    glNamedBufferStorage(myEngine.batches[batchHandle].transformBuffer, MY_ALLOCATOR_BATCH_ENTITY * sizeof(MyTransform), NULL, GL_DYNAMIC_STORAGE_BIT);
-    glNamedBufferStorage(myEngine.batches[batchHandle].indirectBuffer, MY_ALLOCATOR_BATCH_ENTITY * sizeof(MyIndirect), NULL, GL_DYNAMIC_STORAGE_BIT);
-    myEngine.batches[batchHandle].batchHandle = batchHandle;
-    myEngine.batches[batchHandle].textureHandle = myEngine.entities[entityHandle].textureHandle;
-    myEngine.batches[batchHandle].shaderHandle = myEngine.entities[entityHandle].shaderHandle;
-    myEngine.batches[batchHandle].entityType = myEngine.entities[entityHandle].type;
-    myEngine.batches[batchHandle].entityCapacity = MY_ALLOCATOR_BATCH_ENTITY;
-    myEngine.batches[batchHandle].vertexCapacity = MY_ALLOCATOR_BATCH_VERTEX;
-    myEngine.batches[batchHandle].indexCapacity = MY_ALLOCATOR_BATCH_INDEX;
-    return batchHandle;
+    glBlendFuncSeparate(blendSource, blendDestination, blendSourceAlpha, blendDestinationAlpha);
+    myEngine.state.blendSource = blendSource;
+    myEngine.state.blendDestination = blendDestination;
+    myEngine.state.blendSourceAlpha = blendSourceAlpha;
+    myEngine.state.blendDestinationAlpha = blendDestinationAlpha;
+    myEngine.state.issuedCount++;
 }
 
-static void my_batch_destroy(MyHandle batchHandle)
+static void my_state_set_depth_mask(bool depthMask)
 {
-    for (int i = 1; i < myEngine.entityCapacity; i++)
+    if (myEngine.state.depthMask == depthMask)
     {
-        if (myEngine.entities[i].batchHandle == batchHandle)
-        {
-            myEngine.entities[i].batchHandle = MY_INVALID_HANDLE;
-            myEngine.entities[i].entityIndex = 0;
-            myEngine.entities[i].vertexOffset = 0;
-            myEngine.entities[i].indexIndex = 0;
-        }
+        myEngine.state.avoidedCount++;
+        return;
     }
-    if (myEngine.batches[batchHandle].vertexFormat)
+    glDepthMask(depthMask ? GL_TRUE : GL_FALSE);
+    myEngine.state.depthMask = depthMask;
+    myEngine.state.issuedCount++;
+}
+
+static void my_state_set_color(MyColor color)
+{
+    if (!memcmp(&myEngine.state.color, &color, sizeof(MyColor)))
     {
-        glDeleteVertexArrays(1, &myEngine.batches[batchHandle].vertexFormat);
+        myEngine.state.avoidedCount++;
+        return;
     }
-    if (myEngine.batches[batchHandle].vertexBuffer)
+    glClearColor(color.red, color.green, color.blue, color.alpha);
+    myEngine.state.color = color;
+    myEngine.state.issuedCount++;
+}
+
+static void my_state_forget_program(GLuint program)
+{
+    if (myEngine.state.program == program)
     {
-        glDeleteBuffers(1, &myEngine.batches[batchHandle].vertexBuffer);
+        myEngine.state.program = 0;
     }
-    if (myEngine.batches[batchHandle].indexBuffer)
+}
+
+static void my_state_forget_buffer(GLuint buffer)
+{
+    if (myEngine.state.indirectBuffer == buffer)
     {
-        glDeleteBuffers(1, &myEngine.batches[batchHandle].indexBuffer);
+        myEngine.state.indirectBuffer = 0;
     }
-    if (myEngine.batches[batchHandle].transformBuffer)
+    for (int i = 0; i < MY_CAPACITY_STORAGE; i++)
     {
-        glDeleteBuffers(1, &myEngine.batches[batchHandle].transformBuffer);
+        if (myEngine.state.storageBuffers[i] == buffer)
+        {
+            myEngine.state.storageBuffers[i] = 0;
+        }
     }
-    if (myEngine.batches[batchHandle].indirectBuffer)
+    for (int i = 0; i < MY_ENTITY_TYPE_COUNT; i++)
     {
-        glDeleteBuffers(1, &myEngine.batches[batchHandle].indirectBuffer);
+        for (int j = 0; j < MY_CAPACITY_BINDING; j++)
+        {
+            if (myEngine.pools[i].bindingBuffers[j] == buffer)
+            {
+                myEngine.pools[i].bindingBuffers[j] = 0;
+                myEngine.pools[i].bindingOffsets[j] = 0;
+            }
+        }
+        if (myEngine.pools[i].elementBuffer == buffer)
+        {
+            myEngine.pools[i].elementBuffer = 0;
+        }
     }
-    myEngine.batches[batchHandle] = (MyBatch) { 0 };
 }
 
-static MyHandle my_batch_match(MyHandle entityHandle)
+static void my_state_forget_texture(GLuint texture)
 {
-    MyHandle batchHandle = MY_INVALID_HANDLE;
-    for (int i = 1; i < myEngine.batchCapacity; i++)
+    for (int i = 0; i < MY_CAPACITY_SAMPLER; i++)
     {
-        if (myEngine.batches[i].batchHandle &&
-            myEngine.batches[i].textureHandle == myEngine.entities[entityHandle].textureHandle &&
-            myEngine.batches[i].shaderHandle == myEngine.entities[entityHandle].shaderHandle)
+        if (myEngine.state.textures[i] == texture)
         {
-            return i;
+            myEngine.state.textures[i] = 0;
         }
     }
-    return MY_INVALID_HANDLE;
 }
 
-static bool my_batch_add(MyHandle entityHandle)
+static void my_state_forget_vertex_format(GLuint vertexFormat)
 {
-    MyHandle batchHandle = my_batch_match(entityHandle);
-    if (!batchHandle)
+    if (myEngine.state.vertexFormat == vertexFormat)
     {
-        batchHandle = my_batch_create(entityHandle);
-        if (!batchHandle)
-        {
-            return false;
-        }
+        myEngine.state.vertexFormat = 0;
     }
-    if (myEngine.batches[batchHandle].entityCount + 1 > myEngine.batches[batchHandle].entityCapacity)
-    {
-        GLuint transformBuffer;
-        GLuint indirectBuffer;
-        glCreateBuffers(1, &transformBuffer);
-        glCreateBuffers(1, &indirectBuffer);
-        if (!transformBuffer || !indirectBuffer)
-        {
-            return false;
-        }
-        glNamedBufferStorage(myEngine.batches[batchHandle].transformBuffer, (myEngine.batches[batchHandle].entityCapacity + MY_ALLOCATOR_BATCH_ENTITY) * sizeof(MyTransform), NULL, GL_DYNAMIC_STORAGE_BIT);
-        glNamedBufferStorage(myEngine.batches[batchHandle].indirectBuffer, (myEngine.batches[batchHandle].entityCapacity + MY_ALLOCATOR_BATCH_ENTITY) * sizeof(MyIndirect), NULL, GL_DYNAMIC_STORAGE_BIT);
-        glCopyNamedBufferSubData(myEngine.batches[batchHandle].transformBuffer, transformBuffer, 0, 0, myEngine.batches[batchHandle].entityCapacity * sizeof(MyTransform));
-        glCopyNamedBufferSubData(myEngine.batches[batchHandle].indirectBuffer, indirectBuffer, 0, 0, myEngine.batches[batchHandle].entityCapacity * sizeof(MyIndirect));
-        glDeleteBuffers(1, &myEngine.batches[batchHandle].transformBuffer);
-        glDeleteBuffers(1, &myEngine.batches[batchHandle].indirectBuffer);
-        myEngine.batches[batchHandle].transformBuffer = transformBuffer;
-        myEngine.batches[batchHandle].indirectBuffer = indirectBuffer;
-    }
-    // if (myEngine.batches[batchHandle].vertexCount + myEngine.entities[entityHandle].vertexCount > myEngine.batches[batchHandle].vertexCapacity)
-    // {
-    //     GLuint vertexBuffer;
-    //     glCreateBuffers(1, &vertexBuffer);
-    //     if (!vertexBuffer)
-    //     {
-    //         my_batch_destroy(batchHandle);
-    //         return false;
-    //     }
-    //     glNamedBufferStorage(myEngine.batches[batchHandle].vertexBuffer, (myEngine.batches[batchHandle].vertexCapacity + MY_ALLOCATOR_BATCH_ENTITY) * sizeof(MyEntityVertex) * 4, NULL, GL_DYNAMIC_STORAGE_BIT);
-    //     glCopyNamedBufferSubData(myEngine.batches[batchHandle].vertexBuffer, vertexBuffer, 0, 0, myEngine.batches[batchHandle].vertexCapacity * sizeof(MyEntityVertex) * 4);
-    //     glDeleteBuffers(1, &myEngine.batches[batchHandle].vertexBuffer);
-    //     myEngine.batches[batchHandle].vertexBuffer = vertexBuffer;
-    // }
-    // if (myEngine.batches[batchHandle].indexCount + 6 > myEngine.batches[batchHandle].indexCapacity)
-    // {
-    //     GLuint indexBuffer;
-    //     glCreateBuffers(1, &indexBuffer);
-    //     if (!indexBuffer)
-    //     {
-    //         my_batch_destroy(batchHandle);
-    //         return false;
-    //     }
-    //     glNamedBufferStorage(myEngine.batches[batchHandle].indexBuffer, (myEngine.batches[batchHandle].indexCapacity + MY_ALLOCATOR_BATCH_ENTITY) * sizeof(GLushort) * 6, NULL, GL_DYNAMIC_STORAGE_BIT);
-    //     glCopyNamedBufferSubData(myEngine.batches[batchHandle].indexBuffer, indexBuffer, 0, 0, myEngine.batches[batchHandle].indexCapacity * sizeof(GLushort) * 6);
-    //     glDeleteBuffers(1, &myEngine.batches[batchHandle].indexBuffer);
-    //     myEngine.batches[batchHandle].indexBuffer = indexBuffer;
-    // }
-    glNamedBufferSubData(myEngine.batches[batchHandle].vertexBuffer, myEngine.batches[batchHandle].vertexOffset, myEngine.entities[entityHandle].vertexCount * myEngine.entities[entityHandle].vertexSize, myEngine.entities[entityHandle].vertices);
-    glNamedBufferSubData(myEngine.batches[batchHandle].indexBuffer, myEngine.batches[batchHandle].indexCount * sizeof(GLushort), myEngine.entities[entityHandle].indexCount * sizeof(GLushort), myEngine.entities[entityHandle].indices);
-    glNamedBufferSubData(myEngine.batches[batchHandle].transformBuffer, myEngine.batches[batchHandle].entityCount * sizeof(MyTransform), sizeof(MyTransform), &myEngine.entities[entityHandle].transform);
-    const MyIndirect indirect =
-    {
-        myEngine.entities[entityHandle].indexCount,
-        1,
-        myEngine.batches[batchHandle].indexCount,
-        myEngine.batches[batchHandle].vertexCount,
-        myEngine.batches[batchHandle].entityCount
-    };
-    glNamedBufferSubData(myEngine.batches[batchHandle].indirectBuffer, myEngine.batches[batchHandle].entityCount * sizeof(MyIndirect), sizeof(MyIndirect), &indirect);
-    myEngine.entities[entityHandle].batchHandle = batchHandle;
-    myEngine.entities[entityHandle].entityIndex = myEngine.batches[batchHandle].entityCount;
-    myEngine.entities[entityHandle].vertexOffset = myEngine.batches[batchHandle].vertexOffset;
-    myEngine.entities[entityHandle].indexIndex = myEngine.batches[batchHandle].indexCount;
-    myEngine.batches[batchHandle].entityCount++;
-    myEngine.batches[batchHandle].vertexCount += myEngine.entities[entityHandle].vertexCount;
-    myEngine.batches[batchHandle].vertexOffset += myEngine.entities[entityHandle].vertexCount * myEngine.entities[entityHandle].vertexSize;
-    myEngine.batches[batchHandle].indexCount += myEngine.entities[entityHandle].indexCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Thread Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static bool my_thread_create(MyThread* thread, MyThreadFunction function, void* argument)
+{
+#ifdef _WIN32
+    *thread = CreateThread(NULL, 0, function, argument, 0, NULL);
+    return *thread != NULL;
+#else
+    return pthread_create(thread, NULL, function, argument) == 0;
+#endif
+}
+
+static void my_thread_join(MyThread thread)
+{
+#ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+static bool my_mutex_create(MyMutex* mutex)
+{
+#ifdef _WIN32
+    InitializeCriticalSection(mutex);
     return true;
+#else
+    return pthread_mutex_init(mutex, NULL) == 0;
+#endif
 }
 
-static void my_batch_remove(MyHandle entityHandle)
+static void my_mutex_destroy(MyMutex* mutex)
 {
-    const MyHandle batchHandle = myEngine.entities[entityHandle].batchHandle;
-        // todo: swap deleted sprite with last in buffers
-    myEngine.entities[entityHandle].batchHandle = MY_INVALID_HANDLE;
-    myEngine.entities[entityHandle].entityIndex = 0;
-    myEngine.entities[entityHandle].vertexOffset = 0;
-    myEngine.entities[entityHandle].indexCount = 0;
-    myEngine.batches[batchHandle].entityCount--;
-    myEngine.batches[batchHandle].vertexCount -= myEngine.entities[entityHandle].vertexCount;
-    myEngine.batches[batchHandle].vertexOffset -= myEngine.entities[entityHandle].vertexCount * myEngine.entities[entityHandle].vertexSize;
-    myEngine.batches[batchHandle].indexCount-= myEngine.entities[entityHandle].indexCount;
-    if (!myEngine.batches[batchHandle].entityCount)
-    {
-        my_batch_destroy(batchHandle);
-    }
-}
\ No newline at end of file
+#ifdef _WIN32
+    DeleteCriticalSection(mutex);
+#else
+    pthread_mutex_destroy(mutex);
+#endif
+}
+
+static void my_mutex_lock(MyMutex* mutex)
+{
+#ifdef _WIN32
+    EnterCriticalSection(mutex);
+#else
+    pthread_mutex_lock(mutex);
+#endif
+}
+
+static void my_mutex_unlock(MyMutex* mutex)
+{
+#ifdef _WIN32
+    LeaveCriticalSection(mutex);
+#else
+    pthread_mutex_unlock(mutex);
+#endif
+}
+
+static bool my_condition_create(MyCondition* condition)
+{
+#ifdef _WIN32
+    InitializeConditionVariable(condition);
+    return true;
+#else
+    return pthread_cond_init(condition, NULL) == 0;
+#endif
+}
+
+static void my_condition_destroy(MyCondition* condition)
+{
+#ifndef _WIN32
+    pthread_cond_destroy(condition);
+#endif
+}
+
+static void my_condition_wait(MyCondition* condition, MyMutex* mutex)
+{
+#ifdef _WIN32
+    SleepConditionVariableCS(condition, mutex, INFINITE);
+#else
+    pthread_cond_wait(condition, mutex);
+#endif
+}
+
+static void my_condition_broadcast(MyCondition* condition)
+{
+#ifdef _WIN32
+    WakeAllConditionVariable(condition);
+#else
+    pthread_cond_broadcast(condition);
+#endif
+}